@@ -0,0 +1,200 @@
+#ifndef AES_MULTIBUFFER_H
+#define AES_MULTIBUFFER_H
+
+// Пакетное шифрование AES-128-CBC многих независимых сообщений.
+// Внутри одного сообщения CBC последовательный: блок i шифруется только после
+// блока i - 1. Поэтому сообщения раскладываются по AES_LANES дорожкам, и на
+// каждом шаге раунды всех занятых дорожек выполняются вперемешку - задержка
+// одной инструкции AES скрывается работой над соседними сообщениями.
+// Дорожка, закончившая сообщение, сразу получает следующее из очереди.
+//
+// Байты блока в линейном порядке (как в стандарте и в AES-NI); байт j
+// соответствует block[j % 4][j / 4] из aes.h.
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+
+#include "aes.h"
+#include "profiler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AES_MULTIBUFFER_X86 1
+#endif
+
+using namespace std;
+
+// Число сообщений, шифруемых одновременно
+const int AES_LANES = 8;
+
+// Раундовые ключи в линейном порядке байтов
+struct AesKeySchedule {
+    alignas(16) Byte bytes[11][16];
+};
+
+inline AesKeySchedule packKeySchedule(const vector<Block>& roundKeys) {
+    AesKeySchedule schedule;
+    for (int round = 0; round < 11; ++round)
+        for (int j = 0; j < 16; ++j)
+            schedule.bytes[round][j] = roundKeys[round][j % 4][j / 4];
+    return schedule;
+}
+
+// Расширение ключа сразу в линейный порядок байтов: результат тот же, что у
+// packKeySchedule(expandKey(key)), но без промежуточных vector в куче, где
+// раундовые ключи остались бы после освобождения памяти
+inline void expandKeySchedule(const Byte* key, AesKeySchedule& schedule) {
+    Byte* w = &schedule.bytes[0][0];
+    memcpy(w, key, 16);
+    int rconIndex = 1;
+    for (int i = 16; i < 176; i += 4) {
+        Byte t0 = w[i - 4], t1 = w[i - 3], t2 = w[i - 2], t3 = w[i - 1];
+        if (i % 16 == 0) {
+            Byte first = t0;
+            t0 = sbox[t1] ^ Rcon[rconIndex++];
+            t1 = sbox[t2];
+            t2 = sbox[t3];
+            t3 = sbox[first];
+        }
+        w[i] = w[i - 16] ^ t0;
+        w[i + 1] = w[i - 15] ^ t1;
+        w[i + 2] = w[i - 14] ^ t2;
+        w[i + 3] = w[i - 13] ^ t3;
+    }
+}
+
+// Одно сообщение: blocks блоков по 16 байт из input шифруются в output
+// (output может совпадать с input)
+struct CbcJob {
+    const AesKeySchedule* key = nullptr;
+    Byte iv[16] = {};
+    const Byte* input = nullptr;
+    Byte* output = nullptr;
+    size_t blocks = 0;
+};
+
+// =============================================
+//      Шифрование одного блока на каждой дорожке
+// =============================================
+
+// Ядро шифрует state[0..lanes) на месте, дорожка l - ключом keys[l]
+using CbcLaneKernel = void (*)(Byte (*state)[16], const AesKeySchedule* const* keys, int lanes);
+
+inline Block bytesToBlock(const Byte* bytes) {
+    Block block;
+    for (int j = 0; j < 16; ++j) block[j % 4][j / 4] = bytes[j];
+    return block;
+}
+
+inline void blockToBytes(const Block& block, Byte* bytes) {
+    for (int j = 0; j < 16; ++j) bytes[j] = block[j % 4][j / 4];
+}
+
+// Переносимое ядро: раундовые операции из aes.h, дорожки по очереди
+inline void encryptLanesPortable(Byte (*state)[16], const AesKeySchedule* const* keys, int lanes) {
+    for (int l = 0; l < lanes; ++l) {
+        Block s = xorBlocks(bytesToBlock(state[l]), bytesToBlock(keys[l]->bytes[0]));
+        for (int round = 1; round < 10; ++round) {
+            subBytes(s);
+            shiftRows(s);
+            mixColumns(s);
+            s = xorBlocks(s, bytesToBlock(keys[l]->bytes[round]));
+        }
+        subBytes(s);
+        shiftRows(s);
+        blockToBytes(xorBlocks(s, bytesToBlock(keys[l]->bytes[10])), state[l]);
+    }
+}
+
+#ifdef AES_MULTIBUFFER_X86
+// AES-NI: раунд каждой дорожки - одна инструкция aesenc; цикл по дорожкам
+// внутри цикла по раундам дает до 8 независимых aesenc подряд
+__attribute__((target("aes,sse2")))
+inline void encryptLanesAESNI(Byte (*state)[16], const AesKeySchedule* const* keys, int lanes) {
+    __m128i s[AES_LANES];
+    for (int l = 0; l < lanes; ++l) {
+        __m128i key = _mm_load_si128(reinterpret_cast<const __m128i*>(keys[l]->bytes[0]));
+        s[l] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state[l])), key);
+    }
+    for (int round = 1; round < 10; ++round) {
+        for (int l = 0; l < lanes; ++l)
+            s[l] = _mm_aesenc_si128(s[l], _mm_load_si128(reinterpret_cast<const __m128i*>(keys[l]->bytes[round])));
+    }
+    for (int l = 0; l < lanes; ++l) {
+        s[l] = _mm_aesenclast_si128(s[l], _mm_load_si128(reinterpret_cast<const __m128i*>(keys[l]->bytes[10])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[l]), s[l]);
+    }
+}
+#endif
+
+// Выбор самого быстрого ядра, поддерживаемого процессором
+inline CbcLaneKernel selectCbcLaneKernel() {
+#ifdef AES_MULTIBUFFER_X86
+    if (__builtin_cpu_supports("aes")) return encryptLanesAESNI;
+#endif
+    return encryptLanesPortable;
+}
+
+// =============================================
+//      Планировщик заданий по дорожкам
+// =============================================
+
+// Результат совпадает с последовательным CBC каждого сообщения по отдельности
+inline void aesCbcEncryptBatch(CbcJob* jobs, size_t count,
+                               CbcLaneKernel kernel = selectCbcLaneKernel()) {
+    PROFILE_SCOPE("aesCbcEncryptBatch");
+    alignas(16) Byte state[AES_LANES][16];
+    Byte chain[AES_LANES][16];
+    const AesKeySchedule* keys[AES_LANES];
+    CbcJob* laneJob[AES_LANES];
+    size_t position[AES_LANES];
+
+    size_t next = 0;
+    int active = 0;
+    while (true) {
+        // Свободные дорожки получают следующие задания
+        while (active < AES_LANES && next < count) {
+            CbcJob& job = jobs[next++];
+            if (job.blocks == 0) continue;
+            laneJob[active] = &job;
+            keys[active] = job.key;
+            position[active] = 0;
+            memcpy(chain[active], job.iv, 16);
+            ++active;
+        }
+        if (active == 0) break;
+
+        for (int l = 0; l < active; ++l) {
+            const Byte* in = laneJob[l]->input + position[l] * 16;
+            for (int j = 0; j < 16; ++j) state[l][j] = in[j] ^ chain[l][j];
+        }
+
+        kernel(state, keys, active);
+
+        for (int l = 0; l < active; ++l) {
+            memcpy(laneJob[l]->output + position[l] * 16, state[l], 16);
+            memcpy(chain[l], state[l], 16);
+            ++position[l];
+        }
+
+        // Закончившие дорожки заменяются последней занятой дорожкой
+        for (int l = 0; l < active;) {
+            if (position[l] < laneJob[l]->blocks) {
+                ++l;
+                continue;
+            }
+            --active;
+            laneJob[l] = laneJob[active];
+            keys[l] = keys[active];
+            position[l] = position[active];
+            memcpy(chain[l], chain[active], 16);
+        }
+    }
+}
+
+inline void aesCbcEncryptBatch(vector<CbcJob>& jobs, CbcLaneKernel kernel = selectCbcLaneKernel()) {
+    aesCbcEncryptBatch(jobs.data(), jobs.size(), kernel);
+}
+
+#endif // AES_MULTIBUFFER_H
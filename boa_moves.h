@@ -0,0 +1,181 @@
+#ifndef BOA_MOVES_H
+#define BOA_MOVES_H
+
+// Подсчет ходов фишки по клеткам удава (laba6_4.cpp).
+// Правило хода (как в исходном цикле): d = цель - позиция;
+// скорость < d - скорость растет на 1, скорость > d - падает на 1 (не ниже 1),
+// затем фишка сдвигается на скорость.
+//
+// Пока скорость меньше остатка, фишка только разгоняется и не перелетает цель.
+// Поэтому путь до цели - k шагов разгона и не более одного последнего шага,
+// а k - наименьший корень квадратного неравенства. Отрезок между целями
+// считается за O(1) независимо от расстояния.
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Наибольший допустимый номер клетки: перелет за цель не превышает скорости
+// (~sqrt(2 * расстояние)), так что позиция не переполняет int64
+const long long BOA_MAX_CELL = 1000000000000000000LL;
+
+// Позиция фишки и текущая скорость
+struct BoaState {
+    long long position = 1; // начинаем с головы удава (клетка 1)
+    long long speed = 0;
+};
+
+// Эталон: ход за ходом, как в исходной программе
+inline long long simulateMoves(BoaState& state, long long target) {
+    long long moves = 0;
+    while (state.position < target) {
+        long long required = target - state.position;
+        if (state.speed < required) {
+            state.speed++;
+        } else if (state.speed > required) {
+            state.speed = max(state.speed - 1, 1LL);
+        }
+        state.position += state.speed;
+        moves++;
+    }
+    return moves;
+}
+
+// Путь, пройденный до начала (j+1)-го шага разгона, плюс скорость на этом
+// шаге: (j + 1) * s0 + j * (j + 1) / 2 + j. Разгон продолжается, пока эта
+// величина меньше исходного остатка d0.
+inline __int128 boaAccelerationBound(long long s0, long long j) {
+    __int128 k = j;
+    return (k + 1) * s0 + k * (k + 1) / 2 + k;
+}
+
+// То же, что simulateMoves, за O(1)
+inline long long advanceMoves(BoaState& state, long long target) {
+    if (state.position >= target) return 0;
+
+    long long s0 = state.speed;
+    long long d0 = target - state.position;
+
+    // k - наименьшее j >= 0 с boaAccelerationBound(s0, j) >= d0, т.е. корень
+    // j^2 + (2 s0 + 3) j + 2 s0 - 2 d0 = 0; приближение уточняется целыми
+    long double b = 2.0L * s0 + 3.0L;
+    long double root = (sqrtl(b * b - 8.0L * s0 + 8.0L * d0) - b) / 2.0L;
+    long long k = max(0LL, static_cast<long long>(ceill(root)));
+    while (k > 0 && boaAccelerationBound(s0, k - 1) >= d0) --k;
+    while (boaAccelerationBound(s0, k) < d0) ++k;
+
+    // После k шагов разгона
+    __int128 travelled = static_cast<__int128>(k) * s0 + static_cast<__int128>(k) * (k + 1) / 2;
+    long long speed = s0 + k;
+    long long rest = d0 - static_cast<long long>(travelled);
+    long long moves = k;
+
+    // Остаток не больше скорости: один последний шаг точно в цель
+    // или с торможением и перелетом
+    if (rest > 0) {
+        if (speed > rest) speed = max(speed - 1, 1LL);
+        rest -= speed;
+        moves++;
+    }
+
+    state.speed = speed;
+    state.position = target - rest;
+    return moves;
+}
+
+// Общее количество ходов для возрастающей последовательности клеток
+inline long long countMoves(const long long* cells, size_t count) {
+    BoaState state;
+    long long moves = 0;
+    for (size_t i = 0; i < count; ++i) {
+        moves += advanceMoves(state, cells[i]);
+    }
+    return moves;
+}
+
+// Разбор запроса "K c1 ... cK" из одной строки; false при ошибке формата,
+// неверном K или нарушении ограничений на клетки
+inline bool parseBoaQuery(const char* begin, const char* end, vector<long long>& cells) {
+    cells.clear();
+    const char* p = begin;
+    long long K = -1;
+    while (p < end) {
+        char c = *p;
+        if (c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r') {
+            ++p;
+            continue;
+        }
+        long long value;
+        auto result = from_chars(p, end, value);
+        if (result.ec != errc()) return false;
+        p = result.ptr;
+
+        if (K < 0) {
+            if (value <= 0) return false;
+            K = value;
+            continue;
+        }
+        if (value < 1 || value > BOA_MAX_CELL) return false;
+        if (!cells.empty() && value <= cells.back()) return false;
+        cells.push_back(value);
+    }
+    return K > 0 && static_cast<long long>(cells.size()) == K;
+}
+
+// Ответы на запросы из текста [begin, end), по одному запросу на строку.
+// Пустые строки пропускаются; на некорректный запрос ответ -1.
+// Текст делится на куски по границам строк, куски обрабатываются параллельно,
+// ответы складываются по порядку строк.
+inline vector<long long> answerBoaQueries(const char* begin, const char* end, int threads = 0) {
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    size_t size = end - begin;
+    threads = static_cast<int>(min<size_t>(threads, max<size_t>(1, size / (1 << 16))));
+
+    // Границы кусков сдвигаются к началу следующей строки
+    vector<const char*> bounds(threads + 1, end);
+    bounds[0] = begin;
+    for (int t = 1; t < threads; ++t) {
+        const char* p = max(bounds[t - 1], begin + size / threads * t);
+        while (p < end && p[-1] != '\n') ++p;
+        bounds[t] = p;
+    }
+
+    vector<vector<long long>> partial(threads);
+    auto work = [&bounds, &partial](int t) {
+        vector<long long> cells;
+        const char* line = bounds[t];
+        const char* limit = bounds[t + 1];
+        while (line < limit) {
+            const char* lineEnd = static_cast<const char*>(memchr(line, '\n', limit - line));
+            if (!lineEnd) lineEnd = limit;
+            const char* p = line;
+            while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+            if (p < lineEnd) {
+                partial[t].push_back(parseBoaQuery(line, lineEnd, cells)
+                                         ? countMoves(cells.data(), cells.size()) : -1);
+            }
+            line = lineEnd + 1;
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (thread& th : pool) th.join();
+
+    vector<long long> answers;
+    for (const vector<long long>& part : partial) {
+        answers.insert(answers.end(), part.begin(), part.end());
+    }
+    return answers;
+}
+
+#endif // BOA_MOVES_H
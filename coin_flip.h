@@ -0,0 +1,215 @@
+#ifndef COIN_FLIP_H
+#define COIN_FLIP_H
+
+// Приведение доски из монет к шахматному узору (laba6_5.cpp).
+// Эталон minFlips работает с доской из int клетка за клеткой; быстрый
+// вариант minFlipsBits - с доской из упакованных строк битов (64 клетки в слове).
+//
+// Жадный алгоритм minFlips идет по строке слева направо и переворачивает
+// клетку j вместе с j + 1, если клетка не совпадает с узором. Переворот в j
+// происходит ровно тогда, когда нечетно число несовпадений в клетках 0..j,
+// т.е. маска переворотов - префиксный XOR маски несовпадений. Переворот
+// последней клетки строки уходит вниз и меняет последнюю клетку следующей
+// строки. Так вся строка обрабатывается сдвигами слов без цикла по клеткам.
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// =============================================
+//      Эталон: доска из int, клетка за клеткой
+// =============================================
+
+// Функция для проверки, является ли доска шахматной
+inline bool isChessboard(const vector<vector<int>>& board, int pattern) {
+    int n = board.size(), m = n ? board[0].size() : 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            int expected = (i + j + pattern) % 2;
+            if (board[i][j] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Функция для переворота монеты
+inline void flipCoin(vector<vector<int>>& board, int i, int j) {
+    if (i >= 0 && i < static_cast<int>(board.size()) && j >= 0 && j < static_cast<int>(board[0].size())) {
+        board[i][j] ^= 1; // Переворачиваем монету
+    }
+}
+
+// Функция для подсчета минимального количества ходов
+inline int minFlips(vector<vector<int>>& board) {
+    int n = board.size();
+    if (n == 0) return 0;
+    int m = board[0].size();
+
+    // Два возможных шахматных паттерна
+    int min_flips = INT_MAX;
+
+    for (int pattern = 0; pattern < 2; ++pattern) {
+        vector<vector<int>> temp = board;
+        int flips = 0;
+
+        // Пытаемся преобразовать доску в текущий паттерн
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                int expected = (i + j + pattern) % 2;
+                if (temp[i][j] != expected) {
+                    // Переворачиваем текущую монету и соседнюю (правую или нижнюю)
+                    flipCoin(temp, i, j);
+                    if (j + 1 < m) {
+                        flipCoin(temp, i, j + 1);
+                    } else if (i + 1 < n) {
+                        flipCoin(temp, i + 1, j);
+                    } else {
+                        // Невозможно сделать ход - паттерн недостижим
+                        flips = INT_MAX;
+                        break;
+                    }
+                    flips++;
+                }
+            }
+            if (flips == INT_MAX) break;
+        }
+
+        if (flips < min_flips) {
+            min_flips = flips;
+        }
+    }
+
+    return (min_flips == INT_MAX) ? -1 : min_flips;
+}
+
+// =============================================
+//      Упакованная доска
+// =============================================
+
+// Биты с четными номерами 0, 2, 4, ...
+const uint64_t EVEN_BITS = 0x5555555555555555ull;
+
+// Доска rows x cols, каждая строка занимает words слов
+struct PackedBoard {
+    int rows = 0;
+    int cols = 0;
+    size_t words = 0;
+    vector<uint64_t> bits;
+
+    PackedBoard() = default;
+    PackedBoard(int rows, int cols)
+        : rows(rows), cols(cols), words((static_cast<size_t>(cols) + 63) / 64),
+          bits(static_cast<size_t>(rows) * words, 0) {}
+
+    uint64_t* row(int i) { return bits.data() + static_cast<size_t>(i) * words; }
+    const uint64_t* row(int i) const { return bits.data() + static_cast<size_t>(i) * words; }
+
+    int get(int i, int j) const { return static_cast<int>((row(i)[j / 64] >> (j % 64)) & 1); }
+    void set(int i, int j, int value) {
+        uint64_t bit = 1ull << (j % 64);
+        if (value) row(i)[j / 64] |= bit;
+        else row(i)[j / 64] &= ~bit;
+    }
+};
+
+// Упаковка доски из 0/1
+inline PackedBoard packBoard(const vector<vector<int>>& board) {
+    int n = static_cast<int>(board.size());
+    PackedBoard packed(n, n > 0 ? static_cast<int>(board[0].size()) : 0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < packed.cols; ++j) {
+            if (board[i][j]) packed.row(i)[j / 64] |= 1ull << (j % 64);
+        }
+    }
+    return packed;
+}
+
+// Доска из непрерывной последовательности битов: клетка (i, j) - бит i * cols + j
+inline PackedBoard packBits(const uint64_t* src, int rows, int cols) {
+    PackedBoard packed(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        size_t first = static_cast<size_t>(i) * cols;
+        uint64_t* dst = packed.row(i);
+        for (size_t w = 0; w < packed.words; ++w) {
+            size_t bit = first + w * 64;
+            size_t shift = bit % 64;
+            uint64_t word = src[bit / 64] >> shift;
+            size_t remaining = static_cast<size_t>(cols) - w * 64;
+            if (shift != 0 && remaining > 64 - shift) word |= src[bit / 64 + 1] << (64 - shift);
+            if (remaining < 64) word &= (1ull << remaining) - 1;
+            dst[w] = word;
+        }
+    }
+    return packed;
+}
+
+// Префиксный XOR: бит j результата - XOR битов 0..j
+inline uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Результат жадного алгоритма, совпадает с minFlips: минимум по двум узорам
+// или -1, если оба узора недостижимы.
+// Узор 1 - инверсия узора 0, поэтому его маска переворотов отличается от
+// маски узора 0 в клетках с четным номером (префикс нечетной длины); оба узора
+// считаются за один проход по доске.
+inline long long minFlipsBits(const PackedBoard& board) {
+    int n = board.rows, m = board.cols;
+    if (n == 0 || m == 0) return 0;
+
+    size_t lastWord = board.words - 1;
+    int lastBit = (m - 1) % 64;
+    // Клетки строки без последней: ее переворот считается отдельно
+    uint64_t lastWordMask = lastBit == 63 ? ~0ull : (1ull << (lastBit + 1)) - 1;
+    lastWordMask &= ~(1ull << lastBit);
+    uint64_t patternShift = m % 2; // сдвиг префикса узора 1 в последней клетке
+
+    long long flips[2] = {0, 0};
+    bool possible[2] = {true, true};
+    uint64_t carryDown[2] = {0, 0}; // переворот, ушедший в следующую строку
+
+    for (int i = 0; i < n; ++i) {
+        // Узор 0 в строке i: единицы там, где i + j нечетно
+        uint64_t expected = (i % 2) ? EVEN_BITS : ~EVEN_BITS;
+        const uint64_t* row = board.row(i);
+
+        uint64_t carry = 0;
+        long long count0 = 0, count1 = 0;
+        uint64_t prefix = 0;
+        for (size_t w = 0; w <= lastWord; ++w) {
+            prefix = prefixXor(row[w] ^ expected) ^ (0 - carry);
+            carry = prefix >> 63;
+            uint64_t mask = w == lastWord ? lastWordMask : ~0ull;
+            count0 += __builtin_popcountll(prefix & mask);
+            count1 += __builtin_popcountll((prefix ^ EVEN_BITS) & mask);
+        }
+
+        uint64_t last = (prefix >> lastBit) & 1;
+        uint64_t flipLast[2] = {last ^ carryDown[0], last ^ patternShift ^ carryDown[1]};
+        long long counts[2] = {count0, count1};
+        for (int q = 0; q < 2; ++q) {
+            flips[q] += counts[q] + static_cast<long long>(flipLast[q]);
+            if (flipLast[q] && i + 1 == n) possible[q] = false;
+            carryDown[q] = flipLast[q];
+        }
+    }
+
+    if (!possible[0] && !possible[1]) return -1;
+    if (!possible[0]) return flips[1];
+    if (!possible[1]) return flips[0];
+    return min(flips[0], flips[1]);
+}
+
+#endif // COIN_FLIP_H
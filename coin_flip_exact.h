@@ -0,0 +1,420 @@
+#ifndef COIN_FLIP_EXACT_H
+#define COIN_FLIP_EXACT_H
+
+// Точный минимум ходов для доски из монет (laba6_5.cpp): ход - переворот
+// двух соседних клеток (по горизонтали или вертикали), цель - любой из двух
+// шахматных узоров (isChessboard, pattern 0 и 1).
+//
+// Доска - 64-битная маска (клетка (i, j) - бит i * cols + j). Поиск -
+// двунаправленный BFS: от исходной доски и одновременно от обоих узоров;
+// каждый раз раскрывается меньший фронт, уровень делится между потоками,
+// посещенные состояния хранятся в хеш-таблице с открытой адресацией и
+// вставкой через CAS. Число состояний ограничено бюджетом.
+//
+// Ход - XOR с маской из двух битов, поэтому расстояние от доски до узора
+// равно расстоянию от 0 до (доска XOR узор). Для малых досок это позволяет
+// одним BFS от 0 получить точный ответ сразу для всех досок
+// (checkGreedyOptimality).
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+
+#include "coin_flip.h"
+#include "matrix_gen.h"
+
+using namespace std;
+
+// Наибольшее число клеток для точного поиска (старшие 8 бит записи
+// хеш-таблицы занимает расстояние)
+const int EXACT_MAX_CELLS = 56;
+// Бюджет состояний на каждую сторону поиска по умолчанию
+const size_t EXACT_STATE_BUDGET = 1 << 22;
+
+// Маска доски; cols * rows <= 64
+inline uint64_t boardMask(const PackedBoard& board) {
+    uint64_t mask = 0;
+    for (int i = 0; i < board.rows; ++i) {
+        for (int j = 0; j < board.cols; ++j) {
+            mask |= static_cast<uint64_t>(board.get(i, j)) << (i * board.cols + j);
+        }
+    }
+    return mask;
+}
+
+// Маска шахматного узора: клетка (i, j) равна (i + j + pattern) % 2
+inline uint64_t chessMask(int rows, int cols, int pattern) {
+    uint64_t mask = 0;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            if ((i + j + pattern) % 2) mask |= 1ull << (i * cols + j);
+        }
+    }
+    return mask;
+}
+
+// Все ходы доски: маски пар соседних клеток
+inline vector<uint64_t> dominoMoves(int rows, int cols) {
+    vector<uint64_t> moves;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            uint64_t cell = 1ull << (i * cols + j);
+            if (j + 1 < cols) moves.push_back(cell | (cell << 1));
+            if (i + 1 < rows) moves.push_back(cell | (cell << cols));
+        }
+    }
+    return moves;
+}
+
+// Нижняя оценка числа ходов до состояния, отличающегося на маску diff.
+// Каждый ход исправляет не более двух несовпадений, поэтому ходов не меньше
+// половины их числа. Кроме того, несовпадение без соседей-несовпадений
+// требует пути длиной не меньше 2 до своей пары: каждое такое добавляет
+// еще половину хода.
+struct FlipLowerBound {
+    int cols = 0;
+    uint64_t notFirstCol = 0, notLastCol = 0;
+
+    FlipLowerBound(int rows, int cols) : cols(cols) {
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                uint64_t cell = 1ull << (i * cols + j);
+                if (j > 0) notFirstCol |= cell;
+                if (j + 1 < cols) notLastCol |= cell;
+            }
+        }
+    }
+
+    int operator()(uint64_t diff) const {
+        uint64_t neighbours = ((diff & notLastCol) << 1) | ((diff & notFirstCol) >> 1)
+                              | (diff << cols) | (diff >> cols);
+        uint64_t isolated = diff & ~neighbours;
+        return (__builtin_popcountll(diff) + __builtin_popcountll(isolated) + 1) / 2;
+    }
+};
+
+// Множество посещенных состояний с расстояниями. Запись - состояние в младших
+// 56 битах и расстояние в старших 8; вставка из нескольких потоков без
+// блокировок (CAS по пустой ячейке), размер фиксирован при создании.
+class ConcurrentStateSet {
+public:
+    // Не более capacity состояний; дальнейшие вставки отклоняются и
+    // выставляют overflowed()
+    explicit ConcurrentStateSet(size_t capacity) : capacity(capacity) {
+        size_t size = 16;
+        while (size < capacity * 2) size *= 2;
+        slots = vector<atomic<uint64_t>>(size);
+        for (atomic<uint64_t>& slot : slots) slot.store(EMPTY, memory_order_relaxed);
+        mask = size - 1;
+    }
+
+    // true - состояние добавлено впервые
+    bool insert(uint64_t state, int distance) {
+        uint64_t entry = state | (static_cast<uint64_t>(distance) << 56);
+        for (size_t slot = hash(state);; slot = (slot + 1) & mask) {
+            uint64_t current = slots[slot].load(memory_order_relaxed);
+            if (current == EMPTY) {
+                if (used.load(memory_order_relaxed) >= capacity) {
+                    overflow.store(true, memory_order_relaxed);
+                    return false;
+                }
+                if (slots[slot].compare_exchange_strong(current, entry, memory_order_relaxed)) {
+                    used.fetch_add(1, memory_order_relaxed);
+                    return true;
+                }
+                // ячейку занял другой поток - current содержит его запись
+            }
+            if ((current & STATE_MASK) == state) return false;
+        }
+    }
+
+    // Расстояние до состояния или -1, если оно не посещено
+    int find(uint64_t state) const {
+        for (size_t slot = hash(state);; slot = (slot + 1) & mask) {
+            uint64_t current = slots[slot].load(memory_order_relaxed);
+            if (current == EMPTY) return -1;
+            if ((current & STATE_MASK) == state) return static_cast<int>(current >> 56);
+        }
+    }
+
+    size_t size() const { return used.load(memory_order_relaxed); }
+    bool overflowed() const { return overflow.load(memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ull;
+    static constexpr uint64_t STATE_MASK = (1ull << 56) - 1;
+
+    vector<atomic<uint64_t>> slots;
+    size_t mask = 0;
+    size_t capacity;
+    atomic<size_t> used{0};
+    atomic<bool> overflow{false};
+
+    size_t hash(uint64_t state) const {
+        return static_cast<size_t>((state * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+    }
+};
+
+// moves = -1 - ни один узор недостижим; complete = false - бюджет состояний
+// исчерпан (или доска больше EXACT_MAX_CELLS клеток), moves не определен
+struct ExactFlipResult {
+    long long moves = -1;
+    bool complete = true;
+    size_t statesVisited = 0;
+};
+
+// Раскрытие одного уровня фронта: новые состояния добавляются в own с
+// расстоянием depth + 1; встреча с другой стороной уменьшает best.
+// Состояние отбрасывается, если depth + 1 + remaining(state) > limit:
+// remaining - нижняя оценка оставшихся ходов, limit - известный ответ.
+template <typename Remaining>
+vector<uint64_t> expandFrontier(const vector<uint64_t>& frontier, const vector<uint64_t>& moves,
+                                ConcurrentStateSet& own, const ConcurrentStateSet& other,
+                                int depth, int limit, const Remaining& remaining, int threads, int& best) {
+    // Мелкие фронты не стоят запуска потоков
+    int chunks = static_cast<int>(min<size_t>(max(1, threads), 1 + frontier.size() / 4096));
+    vector<vector<uint64_t>> next(chunks);
+    vector<int> bestPerChunk(chunks, INT_MAX);
+    size_t chunk = (frontier.size() + chunks - 1) / chunks;
+
+    parallelChunks(frontier.size(), max<size_t>(chunk, 1), chunks, [&](size_t from, size_t to) {
+        size_t c = from / max<size_t>(chunk, 1);
+        for (size_t f = from; f < to; ++f) {
+            for (uint64_t move : moves) {
+                uint64_t state = frontier[f] ^ move;
+                if (depth + 1 + remaining(state) > limit) continue;
+                int otherDistance = other.find(state);
+                if (otherDistance >= 0 && depth + 1 + otherDistance <= limit) {
+                    bestPerChunk[c] = min(bestPerChunk[c], depth + 1 + otherDistance);
+                }
+                if (own.insert(state, depth + 1)) next[c].push_back(state);
+            }
+        }
+    });
+
+    vector<uint64_t> merged;
+    for (int c = 0; c < chunks; ++c) {
+        best = min(best, bestPerChunk[c]);
+        merged.insert(merged.end(), next[c].begin(), next[c].end());
+    }
+    return merged;
+}
+
+// Один двунаправленный BFS от start до ближайшей из targets с отсечением
+// путей длиннее limit (остаток пути оценивается снизу через bound).
+// Возвращает длину кратчайшего пути или -1, если пути не длиннее limit нет;
+// complete = false - бюджет исчерпан.
+inline int boundedBidirectionalSearch(uint64_t start, const vector<uint64_t>& targets,
+                                      const vector<uint64_t>& moves, const FlipLowerBound& bound,
+                                      int limit, size_t stateBudget, int threads, ExactFlipResult& result) {
+    auto toTargets = [&targets, &bound](uint64_t state) {
+        int best = INT_MAX;
+        for (uint64_t target : targets) best = min(best, bound(state ^ target));
+        return best;
+    };
+    auto toStart = [start, &bound](uint64_t state) { return bound(state ^ start); };
+
+    ConcurrentStateSet forward(stateBudget), backward(stateBudget);
+    vector<uint64_t> forwardFrontier{start}, backwardFrontier = targets;
+    forward.insert(start, 0);
+    for (uint64_t target : targets) backward.insert(target, 0);
+    int forwardDepth = 0, backwardDepth = 0;
+    int found = -1;
+
+    while (!forwardFrontier.empty() && !backwardFrontier.empty()) {
+        int best = INT_MAX;
+        // Раскрывается меньший фронт
+        if (forwardFrontier.size() <= backwardFrontier.size()) {
+            forwardFrontier = expandFrontier(forwardFrontier, moves, forward, backward, forwardDepth,
+                                             limit, toTargets, threads, best);
+            ++forwardDepth;
+        } else {
+            backwardFrontier = expandFrontier(backwardFrontier, moves, backward, forward, backwardDepth,
+                                              limit, toStart, threads, best);
+            ++backwardDepth;
+        }
+
+        if (forward.overflowed() || backward.overflowed()) {
+            result.complete = false;
+            break;
+        }
+        if (best != INT_MAX) {
+            found = best;
+            break;
+        }
+    }
+
+    result.statesVisited += forward.size() + backward.size();
+    return found;
+}
+
+// Точный минимум ходов. Граница пути растет от нижней оценки до ответа
+// жадного алгоритма: при узкой границе отсечение оставляет лишь состояния
+// почти на кратчайших путях, поэтому поиск с точной границей дешев. Если
+// ни одна граница меньше жадного ответа не дала пути, он и есть минимум.
+inline ExactFlipResult exactMinFlips(const PackedBoard& board, size_t stateBudget = EXACT_STATE_BUDGET,
+                                     int threads = 0) {
+    ExactFlipResult result;
+    int n = board.rows, m = board.cols;
+    if (n == 0 || m == 0) {
+        result.moves = 0;
+        return result;
+    }
+    if (n * m > EXACT_MAX_CELLS) {
+        result.complete = false;
+        return result;
+    }
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+
+    uint64_t start = boardMask(board);
+    FlipLowerBound bound(n, m);
+    vector<uint64_t> targets;
+    int lowerBound = INT_MAX;
+    for (int pattern = 0; pattern < 2; ++pattern) {
+        uint64_t target = chessMask(n, m, pattern);
+        // Ход не меняет четность числа несовпадений с узором
+        if (__builtin_popcountll(start ^ target) % 2 == 0) {
+            targets.push_back(target);
+            lowerBound = min(lowerBound, bound(start ^ target));
+        }
+    }
+    if (targets.empty()) return result;
+
+    int greedy = static_cast<int>(minFlipsBits(board));
+    vector<uint64_t> moves = dominoMoves(n, m);
+    for (int limit = lowerBound; limit < greedy; ++limit) {
+        // Таблицы начинаются с малого размера и растут до бюджета только
+        // при переполнении: большинству границ хватает тысяч состояний
+        int found = -1;
+        for (size_t capacity = min<size_t>(stateBudget, 1 << 14);; capacity = min(stateBudget, capacity * 8)) {
+            result.complete = true;
+            found = boundedBidirectionalSearch(start, targets, moves, bound, limit, capacity, threads, result);
+            if (result.complete || capacity == stateBudget) break;
+        }
+        if (!result.complete) return result;
+        if (found >= 0) {
+            result.moves = found;
+            return result;
+        }
+    }
+    result.moves = greedy;
+    return result;
+}
+
+// Расстояния от пустой маски до всех 2^(rows * cols) масок (255 - недостижима):
+// параллельный BFS по уровням с CAS по массиву расстояний
+inline vector<uint8_t> allDistances(int rows, int cols, int threads = 0) {
+    size_t count = size_t(1) << (rows * cols);
+    vector<atomic<uint8_t>> distance(count);
+    for (atomic<uint8_t>& d : distance) d.store(255, memory_order_relaxed);
+    vector<uint64_t> moves = dominoMoves(rows, cols);
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+
+    distance[0].store(0, memory_order_relaxed);
+    vector<uint64_t> frontier{0};
+    for (uint8_t depth = 0; !frontier.empty(); ++depth) {
+        vector<vector<uint64_t>> next(threads);
+        size_t chunk = max<size_t>(1, (frontier.size() + threads - 1) / threads);
+        parallelChunks(frontier.size(), chunk, threads, [&](size_t from, size_t to) {
+            vector<uint64_t>& out = next[from / chunk];
+            for (size_t f = from; f < to; ++f) {
+                for (uint64_t move : moves) {
+                    uint64_t state = frontier[f] ^ move;
+                    uint8_t unvisited = 255;
+                    if (distance[state].compare_exchange_strong(unvisited, depth + 1, memory_order_relaxed)) {
+                        out.push_back(state);
+                    }
+                }
+            }
+        });
+        frontier.clear();
+        for (const vector<uint64_t>& part : next) frontier.insert(frontier.end(), part.begin(), part.end());
+    }
+
+    vector<uint8_t> result(count);
+    for (size_t s = 0; s < count; ++s) result[s] = distance[s].load(memory_order_relaxed);
+    return result;
+}
+
+// Итог проверки жадного алгоритма на досках одного размера
+struct GreedyReport {
+    int rows = 0, cols = 0;
+    bool exhaustive = false;     // проверены все 2^(rows * cols) досок
+    long long boards = 0;        // проверено досок
+    long long optimal = 0;       // жадный ответ совпал с точным
+    long long unknown = 0;       // точный поиск не уложился в бюджет
+    uint64_t counterexample = 0; // доска, где жадный ответ хуже (если есть)
+    long long greedyMoves = 0, exactMoves = 0;
+};
+
+// Доски не больше EXHAUSTIVE_MAX_CELLS клеток проверяются все через allDistances
+const int EXHAUSTIVE_MAX_CELLS = 24;
+
+// Сравнение minFlipsBits с точным минимумом: перебор всех досок для малых
+// размеров, иначе samples случайных досок. Если жадный ответ равен нижней
+// оценке FlipLowerBound, точный поиск не запускается.
+inline GreedyReport checkGreedyOptimality(int rows, int cols, long long samples, uint64_t seed,
+                                          size_t stateBudget = EXACT_STATE_BUDGET, int threads = 0) {
+    GreedyReport report;
+    report.rows = rows;
+    report.cols = cols;
+    int cells = rows * cols;
+    uint64_t patterns[2] = {chessMask(rows, cols, 0), chessMask(rows, cols, 1)};
+    PackedBoard board(rows, cols);
+    FlipLowerBound bound(rows, cols);
+    auto load = [&board, rows, cols](uint64_t mask) {
+        for (int i = 0; i < rows; ++i) board.row(i)[0] = (mask >> (i * cols)) & ((1ull << cols) - 1);
+    };
+    auto record = [&report](uint64_t mask, long long greedy, long long exact) {
+        if (greedy == exact) {
+            report.optimal++;
+        } else if (report.boards == report.optimal + report.unknown) {
+            report.counterexample = mask;
+            report.greedyMoves = greedy;
+            report.exactMoves = exact;
+        }
+        report.boards++;
+    };
+
+    if (cells <= EXHAUSTIVE_MAX_CELLS) {
+        report.exhaustive = true;
+        vector<uint8_t> distance = allDistances(rows, cols, threads);
+        for (uint64_t mask = 0; mask < (1ull << cells); ++mask) {
+            int d = min(distance[mask ^ patterns[0]], distance[mask ^ patterns[1]]);
+            load(mask);
+            record(mask, minFlipsBits(board), d == 255 ? -1 : d);
+        }
+        return report;
+    }
+
+    vector<uint64_t> words(samples);
+    randomWords(words.data(), 0, words.size(), seed);
+    for (uint64_t word : words) {
+        uint64_t mask = word & ((1ull << cells) - 1);
+        load(mask);
+        long long greedy = minFlipsBits(board);
+        long long lowerBound = LLONG_MAX;
+        for (uint64_t pattern : patterns) {
+            if (__builtin_popcountll(mask ^ pattern) % 2 == 0) {
+                lowerBound = min<long long>(lowerBound, bound(mask ^ pattern));
+            }
+        }
+        if (greedy == lowerBound) {
+            record(mask, greedy, greedy);
+            continue;
+        }
+        ExactFlipResult exact = exactMinFlips(board, stateBudget, threads);
+        if (!exact.complete) {
+            report.unknown++;
+            report.boards++;
+            continue;
+        }
+        record(mask, greedy, exact.moves);
+    }
+    return report;
+}
+
+#endif // COIN_FLIP_EXACT_H
@@ -0,0 +1,184 @@
+#ifndef CTR_DRBG_H
+#define CTR_DRBG_H
+
+// Криптостойкий генератор ключей и IV (laba6_2.cpp): CTR_DRBG на AES-128
+// по NIST SP 800-90A без функции деривации.
+// Состояние - ключ K и 128-битный счетчик V. Выход - AES_K(V + 1), AES_K(V + 2), ...;
+// после каждой выдачи (K, V) заменяются следующими двумя блоками шифра, так что
+// по текущему состоянию нельзя восстановить уже выданные байты.
+// У каждого потока свой генератор: один раз берет 32 байта энтропии из
+// getrandom, выдает байты из заранее заполненного буфера и повторно берет
+// энтропию после DRBG_RESEED_INTERVAL заполнений буфера. После fork() копия
+// состояния в дочернем процессе выдала бы те же ключи и IV, что и родитель.
+// Поэтому обработчик pthread_atfork в дочернем процессе увеличивает счетчик
+// fork, и генератор, созданный до fork, отбрасывает буфер и берет новую энтропию.
+// Проверка счетчика - обычное чтение из памяти, без системного вызова getpid.
+
+#include <random>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+#include "aes.h"
+#include "aes_multibuffer.h"
+
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+#include <unistd.h>
+#include <pthread.h>
+
+using namespace std;
+
+// Размер буфера выдачи (блоки шифруются по AES_LANES за раз)
+const size_t DRBG_BUFFER_BYTES = 1024;
+// Число заполнений буфера между обращениями к getrandom (16 Мбайт выхода)
+const size_t DRBG_RESEED_INTERVAL = 1 << 14;
+// Длина затравки: ключ и счетчик
+const size_t DRBG_SEED_BYTES = 32;
+
+// Энтропия от ядра; без getrandom (не Linux) - от random_device.
+// Ошибка getrandom фатальна: генератор без энтропии выдал бы предсказуемые ключи
+inline void systemEntropy(Byte* out, size_t n) {
+#ifdef __linux__
+    size_t done = 0;
+    while (done < n) {
+        ssize_t got = getrandom(out + done, n - done, 0);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Ошибка getrandom: " << strerror(errno) << "\n";
+            abort();
+        }
+        done += static_cast<size_t>(got);
+    }
+#else
+    random_device rd;
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<Byte>(rd());
+#endif
+}
+
+// Число fork() в истории процесса. Меняется только в дочернем процессе сразу
+// после fork, когда в нем еще один поток, поэтому атомарность не нужна
+inline unsigned long long drbgForkGeneration = 0;
+
+inline void watchForks() {
+    static const bool registered =
+        pthread_atfork(nullptr, nullptr, [] { ++drbgForkGeneration; }) == 0;
+    if (!registered) {
+        cerr << "Ошибка pthread_atfork: генератор не сможет обнаружить fork\n";
+        abort();
+    }
+}
+
+class CtrDrbg {
+public:
+    CtrDrbg() {
+        watchForks();
+        Byte seed[DRBG_SEED_BYTES];
+        systemEntropy(seed, sizeof(seed));
+        setKey();
+        update(seed); // K = 0, V = 0, затем обновление затравкой
+        memset(seed, 0, sizeof(seed));
+        forkGeneration = drbgForkGeneration;
+    }
+
+    // Новая энтропия смешивается с текущим состоянием
+    void reseed() {
+        Byte seed[DRBG_SEED_BYTES];
+        systemEntropy(seed, sizeof(seed));
+        update(seed);
+        memset(seed, 0, sizeof(seed));
+        refills = 0;
+    }
+
+    void generate(Byte* out, size_t n) {
+        if (forkGeneration != drbgForkGeneration) {
+            // Дочерний процесс после fork(): буфер и состояние - копия родительских
+            memset(buffer, 0, sizeof(buffer));
+            used = DRBG_BUFFER_BYTES;
+            reseed();
+            forkGeneration = drbgForkGeneration;
+        }
+        while (n > 0) {
+            if (used == DRBG_BUFFER_BYTES) refill();
+            size_t chunk = min(n, DRBG_BUFFER_BYTES - used);
+            memcpy(out, buffer + used, chunk);
+            memset(buffer + used, 0, chunk); // выданные байты не остаются в памяти
+            used += chunk;
+            out += chunk;
+            n -= chunk;
+        }
+    }
+
+private:
+    Byte key[16] = {};
+    Byte counter[16] = {};
+    AesKeySchedule schedule;
+    CbcLaneKernel kernel = selectCbcLaneKernel();
+    alignas(16) Byte buffer[DRBG_BUFFER_BYTES];
+    size_t used = DRBG_BUFFER_BYTES;
+    size_t refills = 0;
+    unsigned long long forkGeneration; // drbgForkGeneration при получении энтропии
+
+    void setKey() {
+        expandKeySchedule(key, schedule);
+    }
+
+    // V = V + 1 (big-endian)
+    void increment() {
+        for (int j = 15; j >= 0; --j)
+            if (++counter[j] != 0) break;
+    }
+
+    // Блоки AES_K(V + 1), ..., AES_K(V + blocks) в out; ядро из aes_multibuffer.h
+    // с одним ключом на всех дорожках
+    void keystream(Byte* out, size_t blocks) {
+        const AesKeySchedule* keys[AES_LANES];
+        for (int l = 0; l < AES_LANES; ++l) keys[l] = &schedule;
+        alignas(16) Byte state[AES_LANES][16];
+        for (size_t b = 0; b < blocks; b += AES_LANES) {
+            int lanes = static_cast<int>(min<size_t>(AES_LANES, blocks - b));
+            for (int l = 0; l < lanes; ++l) {
+                increment();
+                memcpy(state[l], counter, 16);
+            }
+            kernel(state, keys, lanes);
+            memcpy(out + b * 16, state, static_cast<size_t>(lanes) * 16);
+        }
+    }
+
+    // CTR_DRBG_Update: (K, V) = первые 32 байта потока XOR provided
+    void update(const Byte* provided) {
+        Byte temp[DRBG_SEED_BYTES];
+        keystream(temp, DRBG_SEED_BYTES / 16);
+        if (provided)
+            for (size_t j = 0; j < DRBG_SEED_BYTES; ++j) temp[j] ^= provided[j];
+        memcpy(key, temp, 16);
+        memcpy(counter, temp + 16, 16);
+        memset(temp, 0, sizeof(temp));
+        setKey();
+    }
+
+    void refill() {
+        if (refills == DRBG_RESEED_INTERVAL) reseed();
+        keystream(buffer, DRBG_BUFFER_BYTES / 16);
+        update(nullptr);
+        ++refills;
+        used = 0;
+    }
+};
+
+// Генератор текущего потока
+inline CtrDrbg& threadDrbg() {
+    thread_local CtrDrbg instance;
+    return instance;
+}
+
+inline void secureRandomBytes(Byte* out, size_t n) {
+    threadDrbg().generate(out, n);
+}
+
+#endif // CTR_DRBG_H
@@ -0,0 +1,249 @@
+#ifndef DOMINANCE_REORDER_H
+#define DOMINANCE_REORDER_H
+
+// Подготовка произвольной системы к методу Зейделя (laba6_3.cpp, laba6_3_bench.cpp).
+// В laba6_3.cpp система переставлена к диагональному преобладанию вручную;
+// здесь перестановка строк ищется автоматически:
+//  1. Паросочетание строк и столбцов с наибольшим произведением |a_ij| на
+//     диагонали (как MC64): стоимость c_ij = log max_k |a_ik| - log |a_ij| >= 0,
+//     минимум суммы ищется венгерским алгоритмом. Если максимумы всех строк
+//     стоят в разных столбцах, это уже оптимум, и алгоритм не нужен (O(n^2)).
+//  2. Масштабирование из двойственных переменных u, v: после него на диагонали
+//     стоят единицы, а все элементы по модулю не больше 1. Метод Зейделя от
+//     масштабирования не зависит, а LU без выбора ведущего элемента
+//     становится устойчивее.
+//  3. Оценка спектрального радиуса rho матрицы итераций Зейделя
+//     -(D + L)^-1 U степенным методом (один шаг стоит как итерация Зейделя).
+//     Число итераций прогнозируется как log(epsilon) / log(rho); если rho >= 1
+//     или прогноз дороже LU-разложения, система сразу решается LU.
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "linear_solvers.h"
+
+using namespace std;
+
+// Шаги степенного метода для оценки rho
+const int SPECTRAL_ITERATIONS = 20;
+
+struct ReorderResult {
+    vector<int> rowOf;          // строка i новой системы - строка rowOf[i] исходной
+    vector<double> rowScale;    // множитель исходной строки
+    vector<double> colScale;    // множитель столбца: x = colScale * y
+    bool usedMatching = false;  // понадобился венгерский алгоритм
+    bool diagonallyDominant = false;
+    double spectralRadius = NAN;
+    int predictedIterations = -1; // -1 - Зейдель не сойдется
+    int seidelIterations = 0;     // выполнено итераций Зейделя (и при неудачной попытке)
+};
+
+// Венгерский алгоритм (минимум суммы cost[i][match[i]]) с потенциалами u, v:
+// u[i] + v[j] <= cost[i][j], равенство на паросочетании. O(n^3)
+inline void hungarian(const vector<vector<double>>& cost, vector<int>& match,
+                      vector<double>& u, vector<double>& v) {
+    int n = cost.size();
+    const double INF = numeric_limits<double>::infinity();
+    vector<double> uu(n + 1, 0.0), vv(n + 1, 0.0);
+    vector<int> p(n + 1, 0), way(n + 1, 0);  // p[j] - строка, назначенная столбцу j (с 1)
+    for (int i = 1; i <= n; i++) {
+        p[0] = i;
+        int j0 = 0;
+        vector<double> minv(n + 1, INF);
+        vector<char> used(n + 1, 0);
+        do {
+            used[j0] = 1;
+            int i0 = p[j0], j1 = 0;
+            double delta = INF;
+            for (int j = 1; j <= n; j++) {
+                if (used[j]) continue;
+                double cur = cost[i0 - 1][j - 1] - uu[i0] - vv[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= n; j++) {
+                if (used[j]) {
+                    uu[p[j]] += delta;
+                    vv[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    match.assign(n, -1);
+    u.assign(uu.begin() + 1, uu.end());
+    v.assign(vv.begin() + 1, vv.end());
+    for (int j = 1; j <= n; j++) match[p[j] - 1] = j - 1;
+}
+
+// Перестановка и масштабирование; false, если у матрицы нет паросочетания
+// из ненулевых элементов (она вырождена)
+inline bool reorderForDominance(const vector<vector<double>>& A, ReorderResult& r) {
+    int n = A.size();
+    vector<double> rowMax(n, 0.0);
+    vector<int> argmax(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (fabs(A[i][j]) > rowMax[i]) {
+                rowMax[i] = fabs(A[i][j]);
+                argmax[i] = j;
+            }
+        }
+        if (rowMax[i] == 0.0) return false;
+    }
+
+    // Строка i встает на место столбца match[i]
+    vector<int> match = argmax;
+    vector<double> u(n, 0.0), v(n, 0.0);
+    vector<char> taken(n, 0);
+    bool distinct = true;
+    for (int i = 0; i < n && distinct; i++) {
+        if (taken[match[i]]) distinct = false;
+        taken[match[i]] = 1;
+    }
+
+    r.usedMatching = !distinct;
+    if (!distinct) {
+        // Нулевые элементы - "запрещенная" стоимость: больше суммы любых допустимых
+        double forbidden = 0;
+        vector<vector<double>> cost(n, vector<double>(n));
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                cost[i][j] = A[i][j] != 0.0 ? log(rowMax[i]) - log(fabs(A[i][j])) : -1.0;
+                forbidden = max(forbidden, cost[i][j]);
+            }
+        }
+        forbidden = (forbidden + 1.0) * (n + 1);
+        for (auto& row : cost)
+            for (double& c : row)
+                if (c < 0) c = forbidden;
+        hungarian(cost, match, u, v);
+        for (int i = 0; i < n; i++) {
+            if (A[i][match[i]] == 0.0) return false;
+        }
+    }
+
+    r.rowOf.assign(n, 0);
+    r.rowScale.assign(n, 0.0);
+    r.colScale.assign(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        r.rowOf[match[i]] = i;
+        r.rowScale[i] = exp(u[i]) / rowMax[i];
+    }
+    for (int j = 0; j < n; j++) r.colScale[j] = exp(v[j]);
+    return true;
+}
+
+// Переставленная и масштабированная система B y = c
+inline void applyReorder(const vector<vector<double>>& A, const vector<double>& b,
+                         const ReorderResult& r, vector<vector<double>>& B, vector<double>& c) {
+    int n = A.size();
+    B.assign(n, vector<double>(n));
+    c.assign(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        int src = r.rowOf[i];
+        for (int j = 0; j < n; j++) B[i][j] = r.rowScale[src] * A[src][j] * r.colScale[j];
+        c[i] = r.rowScale[src] * b[src];
+    }
+}
+
+// Оценка спектрального радиуса матрицы итераций Зейделя: w = -(D + L)^-1 U v,
+// rho - среднее геометрическое отношений норм на второй половине шагов
+inline double estimateSeidelSpectralRadius(const vector<vector<double>>& B,
+                                           int iterations = SPECTRAL_ITERATIONS) {
+    int n = B.size();
+    vector<double> v(n), w(n);
+    for (int i = 0; i < n; i++) v[i] = 1.0 + 0.5 * sin(1.0 + i); // не собственный вектор
+    double logSum = 0;
+    int counted = 0;
+    for (int it = 0; it < iterations; it++) {
+        double normV = 0, normW = 0;
+        for (int i = 0; i < n; i++) {
+            double sum = 0;
+            for (int j = 0; j < i; j++) sum += B[i][j] * w[j];
+            for (int j = i + 1; j < n; j++) sum += B[i][j] * v[j];
+            w[i] = -sum / B[i][i];
+            normV = max(normV, fabs(v[i]));
+            normW = max(normW, fabs(w[i]));
+        }
+        if (normW == 0.0) return 0.0; // итерация сходится за конечное число шагов
+        if (!isfinite(normW)) return numeric_limits<double>::infinity();
+        if (it >= iterations / 2) {
+            logSum += log(normW / normV);
+            counted++;
+        }
+        for (int i = 0; i < n; i++) v[i] = w[i] / normW;
+    }
+    return exp(logSum / max(counted, 1));
+}
+
+// Решение с автоматической перестановкой: метод Зейделя, если он по прогнозу
+// дешевле LU-разложения (как в SolveAuto - не больше n/3 итераций), иначе LU
+// переставленной системы. Для систем меньше 6x6 бюджет - одна итерация, так
+// что они практически всегда решаются LU. В method записывается выбранный
+// путь, в info - подробности
+inline vector<double> SolveReordered(const vector<vector<double>>& A,
+                                     const vector<double>& b,
+                                     string* method = nullptr,
+                                     ReorderResult* info = nullptr,
+                                     double epsilon = EPSILON) {
+    int n = A.size();
+    ReorderResult r;
+    vector<vector<double>> B, L, U;
+    vector<double> c, y;
+
+    if (!reorderForDominance(A, r)) {
+        if (info) *info = r;
+        if (method) *method = "lu";
+        LUDecomposition(A, L, U);
+        return BackwardSubstitution(U, ForwardSubstitution(L, b));
+    }
+
+    applyReorder(A, b, r, B, c);
+    r.diagonallyDominant = analyzeMatrix(B).diagonallyDominant;
+    r.spectralRadius = estimateSeidelSpectralRadius(B);
+    if (r.spectralRadius < 1.0) {
+        double initial = 0; // погрешность нулевого приближения ~ max |y|, оценка по диагонали
+        for (int i = 0; i < n; i++) initial = max(initial, fabs(c[i] / B[i][i]));
+        r.predictedIterations = r.spectralRadius == 0.0 ? 1
+            : max(1, static_cast<int>(ceil(log(epsilon / max(initial, epsilon)) / log(r.spectralRadius))) + 1);
+    }
+
+    int budget = max(1, n / 3);
+    bool solved = false;
+    if (r.predictedIterations > 0 && r.predictedIterations <= budget) {
+        y.assign(n, 0.0);
+        // Прогноз может ошибиться - Зейдель не получает больше бюджета
+        r.seidelIterations = SeidelIterations(B, c, y, epsilon, budget, &solved);
+        if (solved && method) *method = "reordered_seidel";
+    }
+    if (!solved) {
+        LUDecomposition(B, L, U);
+        y = BackwardSubstitution(U, ForwardSubstitution(L, c));
+        if (method) *method = "reordered_lu";
+    }
+
+    vector<double> x(n);
+    for (int j = 0; j < n; j++) x[j] = r.colScale[j] * y[j];
+    if (info) *info = r;
+    return x;
+}
+
+#endif // DOMINANCE_REORDER_H
@@ -0,0 +1,106 @@
+#ifndef DYNAMIC_ROW_INDEX_H
+#define DYNAMIC_ROW_INDEX_H
+
+// Строка с наибольшим числом положительных при потоке изменений отдельных
+// клеток (laba6_11.cpp --updates). Вместо нового обхода всей матрицы
+// хранятся счетчики положительных по строкам и дерево отрезков над ними:
+// в каждом узле - лучшая строка поддерева по правилу betterRow (больше
+// положительных, при равенстве - меньший индекс), в корне - ответ.
+// Изменение клетки без смены знака стоит O(1), со сменой - O(log N);
+// пакет изменений пересчитывает каждый затронутый узел один раз.
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "row_scan.h"
+
+using namespace std;
+
+// Изменение клетки: a[row][col] = value
+struct CellUpdate {
+    int row = 0;
+    int col = 0;
+    int value = 0;
+};
+
+class DynamicRowIndex {
+public:
+    explicit DynamicRowIndex(IntMatrix matrix)
+        : cells(move(matrix)), counts(cells.rows, 0) {
+        CountPositiveFn countPositive = selectCountPositive();
+        for (int i = 0; i < cells.rows; ++i) counts[i] = countPositive(cells[i], cells.cols);
+
+        leaves = 1;
+        while (leaves < cells.rows) leaves *= 2;
+        tree.assign(2 * leaves, -1);
+        for (int i = 0; i < cells.rows; ++i) tree[leaves + i] = i;
+        for (int v = leaves - 1; v >= 1; --v) tree[v] = winner(tree[2 * v], tree[2 * v + 1]);
+    }
+
+    // Тот же ответ, что у findRowWithMostPositives, за O(1)
+    RowScanResult best() const {
+        int row = tree.empty() ? -1 : tree[1];
+        RowScanResult result;
+        if (row >= 0) {
+            result.index = row;
+            result.count = counts[row];
+        }
+        return result;
+    }
+
+    void set(int row, int col, int value) {
+        if (changeCell(row, col, value)) {
+            for (int v = (leaves + row) / 2; v >= 1; v /= 2) tree[v] = winner(tree[2 * v], tree[2 * v + 1]);
+        }
+    }
+
+    // Пакет: сначала все счетчики, затем узлы дерева по уровням снизу вверх,
+    // каждый затронутый узел - один раз
+    void apply(const CellUpdate* updates, size_t count) {
+        dirty.clear();
+        for (size_t u = 0; u < count; ++u) {
+            const CellUpdate& c = updates[u];
+            if (changeCell(c.row, c.col, c.value)) dirty.push_back((leaves + c.row) / 2);
+        }
+        // Все узлы в dirty на одном уровне; после корня остается узел 0
+        while (!dirty.empty() && dirty[0] > 0) {
+            sort(dirty.begin(), dirty.end());
+            dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+            for (int& v : dirty) {
+                tree[v] = winner(tree[2 * v], tree[2 * v + 1]);
+                v /= 2;
+            }
+        }
+    }
+
+    void apply(const vector<CellUpdate>& updates) { apply(updates.data(), updates.size()); }
+
+    int positives(int row) const { return counts[row]; }
+    const IntMatrix& matrix() const { return cells; }
+
+private:
+    IntMatrix cells;
+    vector<int> counts;  // положительных в строке
+    int leaves = 1;      // листьев дерева (степень двойки)
+    vector<int> tree;    // номер лучшей строки поддерева, -1 - пустое поддерево
+    vector<int> dirty;
+
+    int winner(int a, int b) const {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (counts[a] != counts[b]) return counts[a] > counts[b] ? a : b;
+        return min(a, b);
+    }
+
+    // true - изменился счетчик строки
+    bool changeCell(int row, int col, int value) {
+        int& cell = cells[row][col];
+        int delta = (value > 0) - (cell > 0);
+        cell = value;
+        counts[row] += delta;
+        return delta != 0;
+    }
+};
+
+#endif // DYNAMIC_ROW_INDEX_H
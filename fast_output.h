@@ -0,0 +1,110 @@
+#ifndef FAST_OUTPUT_H
+#define FAST_OUTPUT_H
+
+// Быстрый вывод для программ, печатающих матрицы и блоки поэлементно.
+// Числа форматируются через to_chars в собственный буфер, без манипуляторов
+// и виртуальных вызовов iostream на каждый элемент; в поток буфер уходит
+// крупными кусками. Форматы повторяют вывод iostream байт в байт:
+//   integer         - как cout << n;
+//   hex2            - как cout << hex << setw(2) << setfill('0') << (int)b;
+//   fixed(v, w, p)  - как cout << setw(w) << fixed << setprecision(p) << v;
+//   scientific(v, p) - как cout << scientific << setprecision(p) << v.
+// Состояние потока (hex, fill, precision) при этом не меняется.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+class FastOutput {
+public:
+    // Объем буфера, после которого он передается в поток
+    static constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+    explicit FastOutput(ostream& out = cout) : out(&out) {
+        buffer.reserve(FLUSH_THRESHOLD + 64);
+    }
+
+    FastOutput(const FastOutput&) = delete;
+    FastOutput& operator=(const FastOutput&) = delete;
+
+    ~FastOutput() { flush(); }
+
+    void text(const char* s, size_t n) {
+        buffer.insert(buffer.end(), s, s + n);
+        flushIfFull();
+    }
+    void text(const char* s) { text(s, strlen(s)); }
+    void text(const string& s) { text(s.data(), s.size()); }
+
+    void put(char c) {
+        buffer.push_back(c);
+        flushIfFull();
+    }
+
+    void integer(long long value) {
+        char digits[24];
+        char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        text(digits, end - digits);
+    }
+
+    // Байт двумя шестнадцатеричными цифрами (строчные, с ведущим нулем)
+    void hex2(unsigned value) {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        char digits[2] = {HEX_DIGITS[(value >> 4) & 0xF], HEX_DIGITS[value & 0xF]};
+        text(digits, 2);
+    }
+
+    // Фиксированная точка, выравнивание вправо пробелами до width символов
+    void fixed(double value, int width, int precision) {
+        char digits[512];
+        char* end = to_chars(digits, digits + sizeof(digits), value, chars_format::fixed, precision).ptr;
+        pad(width - static_cast<int>(end - digits));
+        text(digits, end - digits);
+    }
+
+    void scientific(double value, int precision) {
+        char digits[64];
+        char* end = to_chars(digits, digits + sizeof(digits), value, chars_format::scientific, precision).ptr;
+        text(digits, end - digits);
+    }
+
+    // Передача накопленного в поток (без сброса самого потока)
+    void flush() {
+        if (!buffer.empty()) {
+            out->write(buffer.data(), static_cast<streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+private:
+    ostream* out;
+    vector<char> buffer;
+
+    void pad(int count) {
+        if (count > 0) buffer.insert(buffer.end(), count, ' ');
+    }
+
+    void flushIfFull() {
+        if (buffer.size() >= FLUSH_THRESHOLD) flush();
+    }
+};
+
+// Общий буфер потока выполнения для вывода в cout. Перед обычным выводом
+// в cout (или вызовом внешней программы) буфер нужно передать в поток -
+// fastOutput().flush(), иначе порядок строк нарушится.
+inline FastOutput& fastOutput() {
+    thread_local FastOutput instance(cout);
+    return instance;
+}
+
+// Отключение синхронизации iostream с stdio; вызывать в начале main
+inline void setupFastOutput() {
+    ios::sync_with_stdio(false);
+}
+
+#endif // FAST_OUTPUT_H
@@ -0,0 +1,154 @@
+#ifndef FIXED_SIZE_SOLVERS_H
+#define FIXED_SIZE_SOLVERS_H
+
+// Решатели малых систем (2x2 .. 8x8) с размером, известным при компиляции.
+// Все данные лежат на стеке, циклы по N раскрываются компилятором,
+// никаких выделений памяти в куче.
+
+#include <cstddef>
+#include <cmath>
+
+using namespace std;
+
+template <int N>
+struct Matrix {
+    double a[N][N];
+
+    double* operator[](int i) { return a[i]; }
+    const double* operator[](int i) const { return a[i]; }
+};
+
+template <int N>
+struct Vector {
+    double v[N];
+
+    double& operator[](int i) { return v[i]; }
+    double operator[](int i) const { return v[i]; }
+};
+
+// Решение Ax = b LU-разложением на копии A (без выбора ведущего элемента,
+// как LUDecomposition). Возвращает false при нулевом ведущем элементе.
+template <int N>
+inline bool SolveFixed(Matrix<N> A, const Vector<N>& b, Vector<N>& x) {
+#pragma GCC unroll 8
+    for (int k = 0; k < N; k++) {
+        if (A[k][k] == 0.0) {
+            return false;
+        }
+#pragma GCC unroll 8
+        for (int i = k + 1; i < N; i++) {
+            double l = A[i][k] / A[k][k];
+            A[i][k] = l;
+#pragma GCC unroll 8
+            for (int j = k + 1; j < N; j++) {
+                A[i][j] -= l * A[k][j];
+            }
+        }
+    }
+
+    // Ly = b (L с единичной диагональю)
+    Vector<N> y = b;
+#pragma GCC unroll 8
+    for (int i = 1; i < N; i++) {
+#pragma GCC unroll 8
+        for (int j = 0; j < i; j++) {
+            y[i] -= A[i][j] * y[j];
+        }
+    }
+
+    // Ux = y
+#pragma GCC unroll 8
+    for (int i = N - 1; i >= 0; i--) {
+        double sum = y[i];
+#pragma GCC unroll 8
+        for (int j = i + 1; j < N; j++) {
+            sum -= A[i][j] * x[j];
+        }
+        x[i] = sum / A[i][i];
+    }
+    return true;
+}
+
+// Число систем, решаемых одновременно в пакетном режиме
+// (по одной системе на SIMD-дорожку: 8 double - один регистр AVX-512,
+// на AVX2 компилятор разбивает вектор на два регистра; выигрыш от пакетного
+// режима заметен при сборке с -march=native)
+const int BATCH_LANES = 8;
+
+// Вектор из BATCH_LANES чисел - по одному элементу из каждой системы группы
+// (векторное расширение GCC/Clang, арифметика выполняется поэлементно)
+typedef double BatchLanes __attribute__((vector_size(BATCH_LANES * sizeof(double))));
+
+// Пакетное решение count систем одного размера. Системы обрабатываются
+// группами по BATCH_LANES: данные группы перекладываются на стеке так, что
+// одинаковые элементы разных систем лежат в одном векторе, и каждая операция
+// исключения выполняется сразу для всех систем группы.
+// Для вырожденных систем (нулевой ведущий элемент) x заполняется NaN.
+// Возвращает число таких систем.
+template <int N>
+inline size_t SolveBatch(const Matrix<N>* A, const Vector<N>* b, Vector<N>* x, size_t count) {
+    const int W = BATCH_LANES;
+    size_t singular = 0;
+
+    for (size_t base = 0; base < count; base += W) {
+        int lanes = count - base < (size_t)W ? (int)(count - base) : W;
+
+        // Пустые дорожки последней группы заполняются единичной системой
+        BatchLanes a[N][N];
+        BatchLanes r[N];
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                a[i][j] = BatchLanes{} + (i == j ? 1.0 : 0.0);
+            }
+            r[i] = BatchLanes{};
+        }
+        for (int l = 0; l < lanes; l++) {
+            for (int i = 0; i < N; i++) {
+                for (int j = 0; j < N; j++) {
+                    a[i][j][l] = A[base + l][i][j];
+                }
+                r[i][l] = b[base + l][i];
+            }
+        }
+
+        // Прямой ход исключения сразу для правой части
+        // (нулевой ведущий элемент дает inf/NaN только в своей дорожке)
+#pragma GCC unroll 8
+        for (int k = 0; k < N; k++) {
+            BatchLanes inv = 1.0 / a[k][k];
+#pragma GCC unroll 8
+            for (int i = k + 1; i < N; i++) {
+                BatchLanes m = a[i][k] * inv;
+                r[i] -= m * r[k];
+#pragma GCC unroll 8
+                for (int j = k + 1; j < N; j++) {
+                    a[i][j] -= m * a[k][j];
+                }
+            }
+        }
+
+        // Обратный ход
+#pragma GCC unroll 8
+        for (int i = N - 1; i >= 0; i--) {
+#pragma GCC unroll 8
+            for (int j = i + 1; j < N; j++) {
+                r[i] -= a[i][j] * r[j];
+            }
+            r[i] /= a[i][i];
+        }
+
+        for (int l = 0; l < lanes; l++) {
+            bool ok = true;
+            for (int k = 0; k < N; k++) {
+                if (a[k][k][l] == 0.0) ok = false;
+            }
+            for (int i = 0; i < N; i++) {
+                x[base + l][i] = ok ? r[i][l] : NAN;
+            }
+            if (!ok) singular++;
+        }
+    }
+    return singular;
+}
+
+#endif // FIXED_SIZE_SOLVERS_H
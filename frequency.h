@@ -0,0 +1,325 @@
+#ifndef FREQUENCY_H
+#define FREQUENCY_H
+
+// Подсчет частот значений и поиск моды (laba6_12.cpp).
+// Для узкого диапазона значений используется плоский массив счетчиков,
+// для широкого - хеш-таблица с открытой адресацией. Большие массивы
+// считаются параллельно: у каждого потока своя гистограмма, в конце они
+// сливаются. Проверка диапазона и вычисление индексов в плоском массиве
+// векторизованы (AVX2 с выбором во время выполнения), сами инкременты -
+// скалярные: одинаковые значения в одном векторе не дают использовать scatter.
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FREQUENCY_X86 1
+#endif
+
+#include "profiler.h"
+
+using namespace std;
+
+// Хеш-таблица "значение -> количество" с линейным пробированием.
+// Пустая ячейка - ячейка с нулевым счетчиком.
+class OpenAddressingCounter {
+public:
+    OpenAddressingCounter() : keys(16), counts(16, 0) {}
+
+    void add(int key, long long amount = 1) {
+        if (amount == 0) return; // нулевой счетчик - пустая ячейка
+        if ((used + 1) * 2 > keys.size()) grow();
+        size_t slot = find(key);
+        if (counts[slot] == 0) {
+            keys[slot] = key;
+            ++used;
+        }
+        counts[slot] += amount;
+    }
+
+    size_t size() const { return used; }
+
+    template <typename F>
+    void forEach(F f) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (counts[i] != 0) f(keys[i], counts[i]);
+        }
+    }
+
+private:
+    vector<int> keys;
+    vector<long long> counts;
+    size_t used = 0;
+
+    // Ячейка с ключом key или первая пустая на пути пробирования
+    size_t find(int key) const {
+        size_t mask = keys.size() - 1;
+        size_t slot = (static_cast<uint32_t>(key) * 0x9E3779B1u) & mask;
+        while (counts[slot] != 0 && keys[slot] != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow() {
+        vector<int> oldKeys;
+        vector<long long> oldCounts;
+        oldKeys.swap(keys);
+        oldCounts.swap(counts);
+        keys.assign(oldKeys.size() * 2, 0);
+        counts.assign(oldKeys.size() * 2, 0);
+        for (size_t i = 0; i < oldKeys.size(); ++i) {
+            if (oldCounts[i] == 0) continue;
+            size_t slot = find(oldKeys[i]);
+            keys[slot] = oldKeys[i];
+            counts[slot] = oldCounts[i];
+        }
+    }
+};
+
+// Наиболее частое значение (при равенстве частот - меньшее значение)
+struct ModeResult {
+    int value = 0;
+    long long count = 0;
+};
+
+// Счетчик частот: плоский массив для диапазона [minValue, maxValue] не шире
+// DENSE_RANGE_LIMIT, значения вне диапазона и широкие диапазоны - в хеш-таблицу
+class FrequencyCounter {
+public:
+    static constexpr long long DENSE_RANGE_LIMIT = 1 << 20;
+
+    // Диапазон неизвестен - только хеш-таблица
+    FrequencyCounter() = default;
+
+    FrequencyCounter(int minValue, int maxValue) {
+        long long range = static_cast<long long>(maxValue) - minValue + 1;
+        if (range > 0 && range <= DENSE_RANGE_LIMIT) {
+            base = minValue;
+            width = static_cast<size_t>(range);
+            wide.assign(width, 0);
+            narrow.assign(width * SUB_HISTOGRAMS, 0);
+        }
+    }
+
+    bool isDense() const { return width > 0; }
+
+    void add(const int* values, size_t n) {
+        if (!isDense()) {
+            for (size_t i = 0; i < n; ++i) sparse.add(values[i]);
+            return;
+        }
+
+        // Частичные 32-битные гистограммы сбрасываются в 64-битные
+        // до возможного переполнения
+        while (n > 0) {
+            if (pending >= PENDING_LIMIT) flush();
+            size_t chunk = min(n, static_cast<size_t>(PENDING_LIMIT - pending));
+            addDense(values, chunk);
+            pending += chunk;
+            values += chunk;
+            n -= chunk;
+        }
+    }
+
+    void merge(const FrequencyCounter& other) {
+        if (isDense() && other.isDense() && base == other.base && width == other.width) {
+            for (size_t v = 0; v < width; ++v) wide[v] += other.total(v);
+        } else {
+            other.forEachDense([this](int value, long long count) { addCount(value, count); });
+        }
+        other.sparse.forEach([this](int value, long long count) { addCount(value, count); });
+    }
+
+    // Обход всех значений с ненулевой частотой
+    template <typename F>
+    void forEach(F f) const {
+        forEachDense(f);
+        sparse.forEach(f);
+    }
+
+    ModeResult mode() const {
+        ModeResult best;
+        forEach([&best](int value, long long count) {
+            if (count > best.count || (count == best.count && value < best.value)) {
+                best.value = value;
+                best.count = count;
+            }
+        });
+        return best;
+    }
+
+private:
+    // Четыре независимые гистограммы: соседние элементы пишут в разные
+    // ячейки, и повтор значения не создает цепочку зависимостей
+    // "загрузка - инкремент - запись" через одну ячейку памяти
+    static constexpr int SUB_HISTOGRAMS = 4;
+    static constexpr uint64_t PENDING_LIMIT = UINT32_MAX;
+
+    int base = 0;
+    size_t width = 0;
+    vector<long long> wide;     // итоговые счетчики
+    vector<uint32_t> narrow;    // SUB_HISTOGRAMS частичных гистограмм подряд
+    uint64_t pending = 0;       // элементов в частичных гистограммах
+    OpenAddressingCounter sparse;
+
+    long long total(size_t v) const {
+        long long sum = wide[v];
+        for (int k = 0; k < SUB_HISTOGRAMS; ++k) sum += narrow[k * width + v];
+        return sum;
+    }
+
+    template <typename F>
+    void forEachDense(F f) const {
+        for (size_t v = 0; v < width; ++v) {
+            long long count = total(v);
+            if (count != 0) f(base + static_cast<int>(v), count);
+        }
+    }
+
+    void addCount(int value, long long count) {
+        long long offset = static_cast<long long>(value) - base;
+        if (isDense() && offset >= 0 && offset < static_cast<long long>(width)) {
+            wide[offset] += count;
+        } else {
+            sparse.add(value, count);
+        }
+    }
+
+    void flush() {
+        for (size_t v = 0; v < width; ++v) {
+            wide[v] = total(v);
+        }
+        fill(narrow.begin(), narrow.end(), 0);
+        pending = 0;
+    }
+
+    void addDense(const int* values, size_t n) {
+#ifdef FREQUENCY_X86
+        if (__builtin_cpu_supports("avx2")) {
+            addDenseAVX2(values, n);
+            return;
+        }
+#endif
+        uint32_t* h0 = narrow.data();
+        uint32_t* h1 = h0 + width;
+        uint32_t* h2 = h1 + width;
+        uint32_t* h3 = h2 + width;
+        // Сдвиг на base и проверка диапазона одним беззнаковым сравнением
+        auto slot = [this](int value) { return static_cast<uint32_t>(value) - static_cast<uint32_t>(base); };
+
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            uint32_t s0 = slot(values[i]), s1 = slot(values[i + 1]);
+            uint32_t s2 = slot(values[i + 2]), s3 = slot(values[i + 3]);
+            if ((s0 < width) & (s1 < width) & (s2 < width) & (s3 < width)) {
+                ++h0[s0];
+                ++h1[s1];
+                ++h2[s2];
+                ++h3[s3];
+            } else {
+                for (size_t k = i; k < i + 4; ++k) addOne(values[k]);
+            }
+        }
+        for (; i < n; ++i) addOne(values[i]);
+    }
+
+#ifdef FREQUENCY_X86
+    // AVX2: вычитание base и проверка диапазона сразу для 8 значений
+    // (беззнаковое s <= width - 1 <=> min(s, width - 1) == s), затем
+    // скалярные инкременты по четырем частичным гистограммам
+    __attribute__((target("avx2")))
+    void addDenseAVX2(const int* values, size_t n) {
+        uint32_t* h[SUB_HISTOGRAMS];
+        for (int k = 0; k < SUB_HISTOGRAMS; ++k) h[k] = narrow.data() + k * width;
+        const __m256i baseV = _mm256_set1_epi32(base);
+        const __m256i limit = _mm256_set1_epi32(static_cast<int>(width - 1));
+        alignas(32) uint32_t s[8];
+
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i slots = _mm256_sub_epi32(v, baseV);
+            __m256i inRange = _mm256_cmpeq_epi32(_mm256_min_epu32(slots, limit), slots);
+            if (_mm256_movemask_epi8(inRange) == -1) {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(s), slots);
+                ++h[0][s[0]];
+                ++h[1][s[1]];
+                ++h[2][s[2]];
+                ++h[3][s[3]];
+                ++h[0][s[4]];
+                ++h[1][s[5]];
+                ++h[2][s[6]];
+                ++h[3][s[7]];
+            } else {
+                for (size_t k = i; k < i + 8; ++k) addOne(values[k]);
+            }
+        }
+        for (; i < n; ++i) addOne(values[i]);
+    }
+#endif
+
+    void addOne(int value) {
+        uint32_t s = static_cast<uint32_t>(value) - static_cast<uint32_t>(base);
+        if (s < width) ++narrow[s];
+        else sparse.add(value);
+    }
+};
+
+// Минимум и максимум массива (цикл без ветвлений - векторизуется компилятором)
+inline void findValueRange(const int* values, size_t n, int& minValue, int& maxValue) {
+    PROFILE_SCOPE("findValueRange");
+    int lo = INT_MAX, hi = INT_MIN;
+    for (size_t i = 0; i < n; ++i) {
+        lo = min(lo, values[i]);
+        hi = max(hi, values[i]);
+    }
+    minValue = lo;
+    maxValue = hi;
+}
+
+// Параллельный подсчет частот массива с известным диапазоном значений:
+// каждый поток (threads = 0 - по числу ядер) заполняет собственный счетчик
+// по своему куску массива, затем счетчики сливаются
+inline FrequencyCounter countFrequencies(const int* values, size_t n,
+                                         int minValue, int maxValue, int threads = 0) {
+    PROFILE_SCOPE("countFrequencies");
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    // Мелкие массивы не стоят запуска потоков
+    size_t maxThreads = max<size_t>(1, n / (1 << 16));
+    threads = static_cast<int>(min<size_t>(threads, maxThreads));
+
+    vector<FrequencyCounter> partial(threads, FrequencyCounter(minValue, maxValue));
+    if (threads == 1) {
+        partial[0].add(values, n);
+        return partial[0];
+    }
+
+    vector<thread> pool;
+    size_t chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        size_t from = min(n, t * chunk);
+        size_t to = min(n, from + chunk);
+        pool.emplace_back([&partial, values, t, from, to]() { partial[t].add(values + from, to - from); });
+    }
+    for (thread& th : pool) th.join();
+
+    for (int t = 1; t < threads; ++t) {
+        partial[0].merge(partial[t]);
+    }
+    return partial[0];
+}
+
+// То же с диапазоном, найденным предварительным проходом
+inline FrequencyCounter countFrequencies(const int* values, size_t n, int threads = 0) {
+    int minValue = 0, maxValue = -1;
+    if (n > 0) findValueRange(values, n, minValue, maxValue);
+    return countFrequencies(values, n, minValue, maxValue, threads);
+}
+
+#endif // FREQUENCY_H
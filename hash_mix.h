@@ -0,0 +1,19 @@
+#ifndef HASH_MIX_H
+#define HASH_MIX_H
+
+// Перемешивание 64-битных чисел: seed строк эскиза (heavy_hitters.h) и
+// элементы системы, вычисляемые по (i, j), в бенчмарке laba6_3_bench.cpp
+
+#include <cstdint>
+
+using namespace std;
+
+// SplitMix64: соседние входы дают независимые на вид выходы
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+#endif // HASH_MIX_H
@@ -0,0 +1,277 @@
+#ifndef HEAVY_HITTERS_H
+#define HEAVY_HITTERS_H
+
+// Приближенный поиск самых частых значений (laba6_12.cpp) для потоков
+// с неограниченным числом различных значений. Память фиксирована:
+//  - Count-Min Sketch: оценка частоты любого значения сверху,
+//    завышение не более epsilon * N с вероятностью не менее 1 - delta;
+//  - Space-Saving: k отслеживаемых значений, завышение каждого не более N / k;
+//    любое значение с частотой больше N / k гарантированно попадает в список.
+// Оба эскиза сливаются, поэтому части матрицы можно обрабатывать параллельно.
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "hash_mix.h"
+#include "profiler.h"
+
+using namespace std;
+
+class CountMinSketch {
+public:
+    // width = ceil(e / epsilon), depth = ceil(ln(1 / delta))
+    CountMinSketch(double epsilon = 1e-4, double delta = 1e-3, uint64_t seed = 1)
+        : width(static_cast<size_t>(ceil(exp(1.0) / epsilon))),
+          depth(max(1, static_cast<int>(ceil(log(1.0 / delta))))),
+          table(width * depth, 0),
+          seeds(depth) {
+        for (int r = 0; r < depth; ++r) {
+            seeds[r] = splitMix64(seed + r) | 1; // нечетный множитель
+        }
+    }
+
+    void add(int value, long long count = 1) {
+        for (int r = 0; r < depth; ++r) {
+            table[r * width + column(r, value)] += count;
+        }
+    }
+
+    // Оценка сверху: минимум по строкам
+    long long estimate(int value) const {
+        long long best = table[column(0, value)];
+        for (int r = 1; r < depth; ++r) {
+            best = min(best, table[r * width + column(r, value)]);
+        }
+        return best;
+    }
+
+    // Слияние с эскизом тех же размеров и seed
+    void merge(const CountMinSketch& other) {
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] += other.table[i];
+        }
+    }
+
+    double epsilon() const { return exp(1.0) / width; }
+    double delta() const { return exp(-static_cast<double>(depth)); }
+
+private:
+    size_t width;
+    int depth;
+    vector<long long> table; // depth строк по width счетчиков
+    vector<uint64_t> seeds;
+
+    size_t column(int r, int value) const {
+        uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(value)) + 1) * seeds[r];
+        return static_cast<size_t>((h >> 32) % width);
+    }
+};
+
+// Отслеживаемое значение: count - оценка сверху, error - возможное завышение
+struct HeavyHitter {
+    int value = 0;
+    long long count = 0;
+    long long error = 0;
+};
+
+// Space-Saving: не более k счетчиков в min-куче по count
+class SpaceSaving {
+public:
+    explicit SpaceSaving(size_t k = 64) : capacity(max<size_t>(1, k)) {
+        heap.reserve(capacity);
+        position.reserve(capacity * 2);
+    }
+
+    void add(int value, long long count = 1) {
+        auto it = position.find(value);
+        if (it != position.end()) {
+            heap[it->second].count += count;
+            siftDown(it->second);
+            return;
+        }
+        if (heap.size() < capacity) {
+            heap.push_back({value, count, 0});
+            position[value] = heap.size() - 1;
+            siftUp(heap.size() - 1);
+            return;
+        }
+        // Вытесняется значение с наименьшим счетчиком, новое наследует его
+        HeavyHitter& minimum = heap[0];
+        position.erase(minimum.value);
+        minimum.error = minimum.count;
+        minimum.count += count;
+        minimum.value = value;
+        position[value] = 0;
+        siftDown(0);
+    }
+
+    // Наименьший счетчик (0, пока заполнены не все k)
+    long long minCount() const {
+        return heap.size() < capacity ? 0 : heap[0].count;
+    }
+
+    // Слияние по схеме Agarwal et al.: отсутствующее в одном из эскизов
+    // значение получает его минимальный счетчик, затем остаются k наибольших
+    void merge(const SpaceSaving& other) {
+        long long minThis = minCount(), minOther = other.minCount();
+        unordered_map<int, HeavyHitter> combined;
+        for (const HeavyHitter& h : heap) {
+            combined[h.value] = {h.value, h.count + minOther, h.error + minOther};
+        }
+        for (const HeavyHitter& h : other.heap) {
+            auto it = combined.find(h.value);
+            if (it != combined.end()) {
+                it->second.count += h.count - minOther;
+                it->second.error += h.error - minOther;
+            } else {
+                combined[h.value] = {h.value, h.count + minThis, h.error + minThis};
+            }
+        }
+
+        vector<HeavyHitter> all;
+        for (const auto& kv : combined) all.push_back(kv.second);
+        sort(all.begin(), all.end(), byCountDesc);
+        if (all.size() > capacity) all.resize(capacity);
+
+        heap.clear();
+        position.clear();
+        for (const HeavyHitter& h : all) {
+            heap.push_back(h);
+            position[h.value] = heap.size() - 1;
+            siftUp(heap.size() - 1);
+        }
+    }
+
+    // Отслеживаемые значения по убыванию счетчика
+    vector<HeavyHitter> top() const {
+        vector<HeavyHitter> result = heap;
+        sort(result.begin(), result.end(), byCountDesc);
+        return result;
+    }
+
+    size_t k() const { return capacity; }
+
+private:
+    size_t capacity;
+    vector<HeavyHitter> heap;
+    unordered_map<int, size_t> position; // значение -> индекс в куче
+
+    static bool byCountDesc(const HeavyHitter& a, const HeavyHitter& b) {
+        if (a.count != b.count) return a.count > b.count;
+        return a.value < b.value;
+    }
+
+    void swapNodes(size_t a, size_t b) {
+        swap(heap[a], heap[b]);
+        position[heap[a].value] = a;
+        position[heap[b].value] = b;
+    }
+
+    void siftUp(size_t i) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (heap[parent].count <= heap[i].count) break;
+            swapNodes(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown(size_t i) {
+        for (;;) {
+            size_t smallest = i;
+            size_t left = 2 * i + 1, right = left + 1;
+            if (left < heap.size() && heap[left].count < heap[smallest].count) smallest = left;
+            if (right < heap.size() && heap[right].count < heap[smallest].count) smallest = right;
+            if (smallest == i) break;
+            swapNodes(i, smallest);
+            i = smallest;
+        }
+    }
+};
+
+// Частое значение с границами: true count лежит в [lowerBound, estimate]
+struct ApproxFrequency {
+    int value = 0;
+    long long estimate = 0;
+    long long lowerBound = 0;
+};
+
+// Объединение двух эскизов: список кандидатов от Space-Saving, оценка
+// частоты - минимум из оценок Space-Saving и Count-Min
+class HeavyHittersSketch {
+public:
+    HeavyHittersSketch(size_t k = 64, double epsilon = 1e-4, double delta = 1e-3, uint64_t seed = 1)
+        : cms(epsilon, delta, seed), topK(k) {}
+
+    void add(const int* values, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            cms.add(values[i]);
+            topK.add(values[i]);
+        }
+        total += n;
+    }
+
+    void merge(const HeavyHittersSketch& other) {
+        cms.merge(other.cms);
+        topK.merge(other.topK);
+        total += other.total;
+    }
+
+    // Самые частые значения по убыванию оценки
+    vector<ApproxFrequency> top() const {
+        vector<ApproxFrequency> result;
+        for (const HeavyHitter& h : topK.top()) {
+            ApproxFrequency f;
+            f.value = h.value;
+            f.estimate = min(h.count, cms.estimate(h.value));
+            f.lowerBound = max(0LL, h.count - h.error);
+            result.push_back(f);
+        }
+        stable_sort(result.begin(), result.end(), [](const ApproxFrequency& a, const ApproxFrequency& b) {
+            if (a.estimate != b.estimate) return a.estimate > b.estimate;
+            return a.value < b.value;
+        });
+        return result;
+    }
+
+    long long count() const { return total; }
+    // Гарантированные границы завышения оценки
+    double spaceSavingErrorBound() const { return static_cast<double>(total) / topK.k(); }
+    double countMinErrorBound() const { return cms.epsilon() * total; }
+    double countMinFailureProbability() const { return cms.delta(); }
+
+private:
+    CountMinSketch cms;
+    SpaceSaving topK;
+    long long total = 0;
+};
+
+// Параллельная обработка массива: у каждого потока свой эскиз, затем слияние
+inline HeavyHittersSketch approximateHeavyHitters(const int* values, size_t n, size_t k,
+                                                  int threads = 0) {
+    PROFILE_SCOPE("approximateHeavyHitters");
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = static_cast<int>(min<size_t>(threads, max<size_t>(1, n / (1 << 16))));
+
+    vector<HeavyHittersSketch> partial(threads, HeavyHittersSketch(k));
+    vector<thread> pool;
+    size_t chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        size_t from = min(n, t * chunk);
+        size_t to = min(n, from + chunk);
+        pool.emplace_back([&partial, values, t, from, to]() { partial[t].add(values + from, to - from); });
+    }
+    for (thread& th : pool) th.join();
+
+    for (int t = 1; t < threads; ++t) {
+        partial[0].merge(partial[t]);
+    }
+    return partial[0];
+}
+
+#endif // HEAVY_HITTERS_H
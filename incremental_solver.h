@@ -0,0 +1,195 @@
+#ifndef INCREMENTAL_SOLVER_H
+#define INCREMENTAL_SOLVER_H
+
+// Повторное решение системы после небольших изменений матрицы (laba6_3_bench.cpp --incremental).
+// Вместо нового LUDecomposition после каждого изменения LU-разложение
+// сохраняется, а накопленные изменения A' = A + U V^T (k изменений ранга 1)
+// учитываются формулой Шермана-Моррисона-Вудбери:
+//   x = y - Z (I + V^T Z)^-1 V^T y,  y = A^-1 b,  Z = A^-1 U,
+// где столбец Z считается один раз для каждого изменения (2n^2 операций).
+// Решение стоит ~2n^2 + 4nk + k^3 вместо 2/3 n^3. Когда k превышает порог,
+// матрица раскладывается заново. Разложение и столбцы Z считаются лениво,
+// при первом solve после изменений, поэтому при решении только методом
+// Зейделя (он стартует с предыдущего решения) LU не строится вовсе.
+// Статистика показывает, сколько операций выполнено и сколько стоило бы
+// решение каждой системы с нуля.
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "linear_solvers.h"
+
+using namespace std;
+
+// Счетчики работы (операции с плавающей точкой)
+struct IncrementalStats {
+    long long updates = 0;          // изменений ранга 1
+    long long solves = 0;
+    long long refactorizations = 0; // LU-разложений, включая первое
+    double flops = 0;               // выполнено
+    double fullFlops = 0;           // стоили бы решения с нуля
+    int lastSeidelIterations = 0;
+    int coldSeidelIterations = 0;   // итерации Зейделя от x = 0 (замер при первом вызове)
+
+    double savedFraction() const { return fullFlops > 0 ? 1.0 - flops / fullFlops : 0.0; }
+};
+
+// Решение малой плотной системы k x k с выбором ведущего элемента (на месте)
+inline bool solveSmallSystem(vector<vector<double>> C, vector<double>& r) {
+    int k = C.size();
+    for (int col = 0; col < k; col++) {
+        int pivot = col;
+        for (int i = col + 1; i < k; i++)
+            if (fabs(C[i][col]) > fabs(C[pivot][col])) pivot = i;
+        if (fabs(C[pivot][col]) < 1e-12) return false;
+        swap(C[pivot], C[col]);
+        swap(r[pivot], r[col]);
+        for (int i = col + 1; i < k; i++) {
+            double f = C[i][col] / C[col][col];
+            for (int j = col; j < k; j++) C[i][j] -= f * C[col][j];
+            r[i] -= f * r[col];
+        }
+    }
+    for (int i = k - 1; i >= 0; i--) {
+        for (int j = i + 1; j < k; j++) r[i] -= C[i][j] * r[j];
+        r[i] /= C[i][i];
+    }
+    return true;
+}
+
+class IncrementalSolver {
+public:
+    // maxRank - сколько изменений накапливать до нового разложения
+    // (0 - по умолчанию sqrt(n): тогда k^3 не больше n^1.5)
+    explicit IncrementalSolver(const vector<vector<double>>& A, int maxRank = 0)
+        : A(A), n(A.size()),
+          maxRank(maxRank > 0 ? maxRank : max(1, static_cast<int>(sqrt(static_cast<double>(A.size()))))),
+          x(A.size(), 0.0) {}
+
+    // a_ij = value: изменение ранга 1 вида (delta e_i) e_j^T
+    void setCoefficient(int i, int j, double value) {
+        double delta = value - A[i][j];
+        if (delta == 0.0) return;
+        A[i][j] = value;
+        vector<double> u(n, 0.0);
+        u[i] = delta;
+        addUpdate(u, j, vector<double>());
+    }
+
+    // A += u v^T
+    void addRank1(const vector<double>& u, const vector<double>& v) {
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) A[i][j] += u[i] * v[j];
+        stats.flops += 2.0 * n * n;
+        addUpdate(u, -1, v);
+    }
+
+    // Решение текущей системы по сохраненному разложению
+    const vector<double>& solve(const vector<double>& b) {
+        stats.solves++;
+        stats.fullFlops += luFlops() + substitutionFlops();
+        if (!factored) refactor();
+        while (Z.size() < updateU.size()) Z.push_back(substitute(updateU[Z.size()]));
+
+        vector<double> y = substitute(b);
+        int k = pending();
+        if (k > 0) {
+            // r = V^T y, C = I + V^T Z
+            vector<double> r(k);
+            vector<vector<double>> C(k, vector<double>(k));
+            for (int a = 0; a < k; a++) {
+                r[a] = dotV(a, y);
+                for (int c = 0; c < k; c++) C[a][c] = (a == c ? 1.0 : 0.0) + dotV(a, Z[c]);
+                // Для v = e_j скалярное произведение - одно чтение
+                stats.flops += (k + 1) * (updateColumn[a] >= 0 ? 1.0 : 2.0 * n);
+            }
+            if (!solveSmallSystem(C, r)) {
+                // Поправка неустойчива - честное разложение текущей матрицы
+                refactor();
+                y = substitute(b);
+            } else {
+                for (int c = 0; c < k; c++)
+                    for (int i = 0; i < n; i++) y[i] -= Z[c][i] * r[c];
+                stats.flops += 2.0 / 3.0 * k * k * k + 2.0 * n * k;
+            }
+        }
+        x = y;
+        return x;
+    }
+
+    // Метод Зейделя от предыдущего решения (любым методом)
+    const vector<double>& solveSeidel(const vector<double>& b, double epsilon = EPSILON,
+                                      int maxIterations = 1000) {
+        stats.solves++;
+        if (stats.coldSeidelIterations == 0) {
+            // Базовая линия для статистики: один раз решаем от x = 0 (в счетчики не входит)
+            vector<double> cold(n, 0.0);
+            stats.coldSeidelIterations = SeidelIterations(A, b, cold, epsilon, maxIterations);
+        }
+        int iterations = SeidelIterations(A, b, x, epsilon, maxIterations);
+        stats.lastSeidelIterations = iterations;
+        stats.flops += iterations * 2.0 * n * n;
+        stats.fullFlops += stats.coldSeidelIterations * 2.0 * n * n;
+        return x;
+    }
+
+    const vector<vector<double>>& matrix() const { return A; }
+    const vector<double>& solution() const { return x; }
+    const IncrementalStats& statistics() const { return stats; }
+    int pending() const { return static_cast<int>(updateColumn.size()); }
+
+private:
+    vector<vector<double>> A;  // текущая матрица
+    int n;
+    int maxRank;
+    vector<double> x;          // последнее решение
+    bool factored = false;     // L, U - разложение матрицы до накопленных изменений
+    vector<vector<double>> L, U;
+    // Накопленные изменения u_a v_a^T; Z[a] = A0^-1 u_a считается при solve.
+    // Для setCoefficient v = e_j хранится номером updateColumn[a] = j
+    vector<vector<double>> updateU, Z, V;
+    vector<int> updateColumn;
+    IncrementalStats stats;
+
+    double luFlops() const { return 2.0 / 3.0 * n * n * static_cast<double>(n); }
+    double substitutionFlops() const { return 2.0 * n * static_cast<double>(n); }
+
+    void refactor() {
+        LUDecomposition(A, L, U);
+        factored = true;
+        updateU.clear();
+        Z.clear();
+        V.clear();
+        updateColumn.clear();
+        stats.refactorizations++;
+        stats.flops += luFlops();
+    }
+
+    vector<double> substitute(const vector<double>& b) {
+        stats.flops += substitutionFlops();
+        return BackwardSubstitution(U, ForwardSubstitution(L, b));
+    }
+
+    // v_a^T w
+    double dotV(int a, const vector<double>& w) const {
+        if (updateColumn[a] >= 0) return w[updateColumn[a]];
+        double sum = 0;
+        for (int i = 0; i < n; i++) sum += V[a][i] * w[i];
+        return sum;
+    }
+
+    void addUpdate(const vector<double>& u, int column, const vector<double>& v) {
+        stats.updates++;
+        if (!factored) return; // A уже содержит изменение, разложение будет новым
+        if (pending() >= maxRank) {
+            factored = false;
+            return;
+        }
+        updateU.push_back(u);
+        V.push_back(v);
+        updateColumn.push_back(column);
+    }
+};
+
+#endif // INCREMENTAL_SOLVER_H
@@ -1,11 +1,146 @@
 #include <iostream>
 #include <vector>
-#include <cstdlib>  // для использования случайных чисел
-#include <ctime>    // для использования случайных чисел
+#include <string>
+#include <cstdlib>
+#include <chrono>
+
+#include "row_scan.h"
+#include "matrix_stream.h"
+#include "matrix_gen.h"
+#include "dynamic_row_index.h"
+#include "fast_output.h"
 
 using namespace std;
 
-int main() {
+// Запуск:
+//   laba6_11 [--no-print] [--save ФАЙЛ] [--seed S] - случайная матрица, порядок N вводится
+//                                                   с клавиатуры; при одном S матрица одна и та же
+//   laba6_11 ФАЙЛ [--print]              - потоковый анализ матрицы из файла (CSV или двоичного)
+//   laba6_11 --updates U [--batch B] [--no-print] [--seed S] - то же, затем U случайных
+//                                        изменений клеток пакетами по B с ответом после каждого пакета
+
+// Вывод найденной строки с наибольшим количеством положительных чисел
+void printBestRow(const RowScanResult& best, RowView resultRow) {
+    // Обработка ситуации, если все числа равны нулю или отрицательны
+    if (best.index == -1 || best.count == 0) {
+        cout << "Нет строки с положительными числами.\n";
+        return;
+    }
+
+    FastOutput& out = fastOutput();
+    out.text("Строка с наибольшим количеством положительных чисел (");
+    out.integer(best.count);
+    out.text("):\n");
+    for (int val : resultRow) {
+        out.integer(val);
+        out.put(' ');
+    }
+    out.put('\n');
+    out.flush();
+}
+
+// Поток изменений клеток: значения из [-100, 100] пакетами по batch,
+// после каждого пакета - ответ по дереву строк (dynamic_row_index.h).
+// В конце ответ сверяется с полным просмотром матрицы
+int applyUpdates(IntMatrix matrix, long long updates, int batch, uint64_t seed) {
+    int rows = matrix.rows, cols = matrix.cols;
+    DynamicRowIndex index(move(matrix));
+    vector<CellUpdate> pending(batch);
+    vector<int> rowsRandom(batch), colsRandom(batch), values(batch);
+    long long changedAnswers = 0;
+    RowScanResult best = index.best();
+    double seconds = 0;
+
+    for (long long done = 0, b = 0; done < updates; done += batch, ++b) {
+        size_t count = static_cast<size_t>(min<long long>(batch, updates - done));
+        // Изменения зависят только от seed (другой поток, чем у матрицы)
+        fillUniformInt(rowsRandom.data(), count, 0, rows - 1, seed + 1 + 3 * b);
+        fillUniformInt(colsRandom.data(), count, 0, cols - 1, seed + 2 + 3 * b);
+        fillUniformInt(values.data(), count, -100, 100, seed + 3 + 3 * b);
+        for (size_t u = 0; u < count; ++u) {
+            pending[u].row = rowsRandom[u];
+            pending[u].col = colsRandom[u];
+            pending[u].value = values[u];
+        }
+
+        auto start = chrono::steady_clock::now();
+        index.apply(pending.data(), count);
+        RowScanResult current = index.best();
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (current.index != best.index || current.count != best.count) ++changedAnswers;
+        best = current;
+    }
+
+    RowScanResult check = findRowWithMostPositives(index.matrix());
+    cout << "Изменений: " << updates << " (пакеты по " << batch << "), ответ менялся "
+         << changedAnswers << " раз, " << seconds << " с на изменения и запросы\n";
+    cout << "Ответ совпадает с полным просмотром: "
+         << (check.index == best.index && check.count == best.count ? "да" : "нет") << "\n";
+    printBestRow(best, rowView(index.matrix(), max(best.index, 0)));
+    return 0;
+}
+
+// Анализ матрицы из файла за один проход
+int analyzeFile(const string& path, bool printMatrix) {
+    if (printMatrix) cout << "Матрица:\n";
+
+    MatrixStatsAccumulator acc(printMatrix ? &cout : nullptr);
+    string error;
+    if (!streamMatrixFile(path, acc, error)) {
+        cerr << "Ошибка: " << error << "\n";
+        return 1;
+    }
+
+    const MatrixStreamStats& stats = acc.stats;
+    RowView resultRow{stats.bestRowValues.data(), static_cast<int>(stats.bestRowValues.size())};
+    printBestRow(stats.bestRow, resultRow);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    setupFastOutput();
+
+    string inputPath, savePath;
+    int printMode = -1; // -1 - по умолчанию, 0 - не выводить матрицу, 1 - выводить
+    uint64_t seed = randomSeed();
+    long long updates = 0;
+    int batch = 1000;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool needsValue = arg == "--save" || arg == "--seed" || arg == "--updates" || arg == "--batch";
+        if (needsValue && i + 1 >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения\n";
+            return 1;
+        }
+        if (arg == "--print") {
+            printMode = 1;
+        } else if (arg == "--no-print") {
+            printMode = 0;
+        } else if (arg == "--save") {
+            savePath = argv[++i];
+        } else if (arg == "--seed") {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--updates") {
+            updates = strtoll(argv[++i], nullptr, 10);
+        } else if (arg == "--batch") {
+            batch = max(1, atoi(argv[++i]));
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            cerr << "Неизвестный параметр: " << arg << "\n";
+            return 1;
+        } else if (!inputPath.empty()) {
+            cerr << "Ошибка: лишний аргумент " << arg << " (файл уже задан: " << inputPath << ")\n";
+            return 1;
+        } else {
+            inputPath = arg;
+        }
+    }
+
+    // Матрица из файла выводится только по запросу
+    if (!inputPath.empty()) {
+        return analyzeFile(inputPath, printMode == 1);
+    }
+
     int N;
 
     // Проверка ввода размера матрицы
@@ -20,53 +155,37 @@ int main() {
         return 1;
     }
 
-    srand(time(nullptr)); // Инициализация генератора случайных чисел текущим временем
+    // Непрерывный блок N x N со случайными числами в диапазоне [-100, 100]
+    // (заполняется параллельно, результат зависит только от seed)
+    IntMatrix matrix = randomMatrix(N, N, -100, 100, seed);
 
-    vector<vector<int>> matrix(N, vector<int>(N));
-
-    // Заполнение матрицы случайными числами в диапазоне [-100, 100]
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < N; ++j) {
-            matrix[i][j] = -100 + rand() % 201;
-        }
+    if (!savePath.empty() && !saveMatrixBinary(savePath, matrix)) {
+        cerr << "Не удалось сохранить матрицу в " << savePath << "\n";
     }
 
     // Вывод матрицы
-    cout << "Матрица:\n";
-    for (const auto& row : matrix) { // Итерация по каждой строке
-        for (int val : row) // Итерация по элементам строки
-            cout << val << "\t"; // Вывод элемента с табуляцией для форматирования
-        cout << "\n";
-    }
-
-    int maxPosCount = -1; // Инициализация переменной для хранения максимального количества положительных чисел
-    int indexOfMaxRow = -1; // Индекс строки с максимальным количеством положительных чисел
-
-    // Поиск строки с наибольшим количеством положительных чисел
-    for (int i = 0; i < N; ++i) {
-        int countPos = 0;
-        for (int val : matrix[i]) {
-            if (val > 0)
-                ++countPos;
-        }
-        if (countPos > maxPosCount) {
-            maxPosCount = countPos;
-            indexOfMaxRow = i;
+    if (printMode != 0) {
+        FastOutput& out = fastOutput();
+        out.text("Матрица:\n");
+        for (int i = 0; i < N; ++i) { // Итерация по каждой строке
+            for (int val : rowView(matrix, i)) { // Итерация по элементам строки
+                out.integer(val);
+                out.put('\t'); // табуляция для форматирования
+            }
+            out.put('\n');
         }
+        out.flush();
     }
 
-    // Обработка ситуации, если все числа равны нулю или отрицательны
-    if (indexOfMaxRow == -1 || maxPosCount == 0) {
-        cout << "Нет строки с положительными числами.\n";
-        return 0;
+    if (updates > 0) {
+        return applyUpdates(move(matrix), updates, batch, seed);
     }
 
-    vector<int> resultRow = matrix[indexOfMaxRow];
+    // Поиск строки с наибольшим количеством положительных чисел
+    // (векторный подсчет, строки делятся между потоками)
+    RowScanResult best = findRowWithMostPositives(matrix);
 
-    cout << "Строка с наибольшим количеством положительных чисел (" << maxPosCount << "):\n";
-    for (int val : resultRow)
-        cout << val << " ";
-    cout << "\n";
+    printBestRow(best, rowView(matrix, max(best.index, 0))); // без копирования строки
 
     return 0;
 }
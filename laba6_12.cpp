@@ -1,13 +1,136 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
+#include <string>
 #include <algorithm>
+#include <optional>
 #include <cstdlib>
-#include <ctime>
+
+#include "matrix_stream.h"
+#include "matrix_gen.h"
+#include "frequency.h"
+#include "heavy_hitters.h"
+#include "fast_output.h"
 
 using namespace std;
 
-int main() {
+// Запуск:
+//   laba6_12 [--no-print] [--save ФАЙЛ] [--seed S] - случайная матрица, размеры M и N вводятся
+//                                                   с клавиатуры; при одном S матрица одна и та же
+//   laba6_12 ФАЙЛ [--print] [--range MIN MAX] - потоковый анализ матрицы из файла (CSV или
+//                                        двоичного); с --range частоты считаются плоским массивом
+// С --approx K вместо точного подсчета используются эскизы фиксированного
+// размера (Count-Min + Space-Saving) и выводятся K самых частых значений.
+
+// Вывод числа с максимальной частотой
+// (при равных частотах выбирается меньшее число)
+void printMostFrequent(const FrequencyCounter& frequency) {
+    ModeResult mode = frequency.mode();
+    long long maxCount = mode.count;
+    int numberWithMaxCount = mode.value;
+
+    // Вывод результата
+    if (maxCount == 1) {
+        cout << "Нет числа, которое встречается более одного раза.\n";
+    } else {
+        cout << "Число, встречающееся наибольшее количество раз: "
+             << numberWithMaxCount
+             << " (" << maxCount << " раз)\n";
+    }
+}
+
+// Вывод приближенного результата с границами погрешности
+void printApproximate(const HeavyHittersSketch& sketch) {
+    vector<ApproxFrequency> top = sketch.top();
+    if (top.empty()) {
+        cout << "Матрица пуста.\n";
+        return;
+    }
+
+    cout << "Приближенно наиболее частое число: " << top[0].value
+         << " (от " << top[0].lowerBound << " до " << top[0].estimate << " раз)\n";
+    cout << "Самые частые числа (число: оценка сверху / снизу):\n";
+    for (const ApproxFrequency& f : top) {
+        cout << f.value << ": " << f.estimate << " / " << f.lowerBound << "\n";
+    }
+    cout << "Завышение оценки: не более " << sketch.spaceSavingErrorBound()
+         << " (Space-Saving), не более " << sketch.countMinErrorBound()
+         << " с вероятностью " << 1.0 - sketch.countMinFailureProbability() << " (Count-Min)\n";
+}
+
+// Анализ матрицы из файла за один проход
+int analyzeFile(const string& path, bool printMatrix, bool hasRange, int minValue, int maxValue,
+                size_t approxK) {
+    if (printMatrix) cout << "Матрица:\n";
+
+    MatrixStatsAccumulator acc(printMatrix ? &cout : nullptr);
+    if (hasRange) acc.setValueRange(minValue, maxValue);
+    // Эскиз (таблица Count-Min ~1.5 Мбайт) создается только для --approx
+    optional<HeavyHittersSketch> sketch;
+    if (approxK > 0) {
+        sketch.emplace(approxK);
+        acc.setApproximate(&*sketch);
+    }
+
+    string error;
+    if (!streamMatrixFile(path, acc, error)) {
+        cerr << "Ошибка: " << error << "\n";
+        return 1;
+    }
+
+    if (sketch) printApproximate(*sketch);
+    else printMostFrequent(acc.stats.frequency);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    setupFastOutput();
+
+    string inputPath, savePath;
+    int printMode = -1; // -1 - по умолчанию, 0 - не выводить матрицу, 1 - выводить
+    bool hasRange = false;
+    int minValue = 0, maxValue = 0;
+    size_t approxK = 0; // 0 - точный подсчет
+    uint64_t seed = randomSeed();
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        // Сколько значений идет за параметром
+        int valueCount = arg == "--range" ? 2
+            : (arg == "--save" || arg == "--approx" || arg == "--seed") ? 1 : 0;
+        if (i + valueCount >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения\n";
+            return 1;
+        }
+        if (arg == "--print") {
+            printMode = 1;
+        } else if (arg == "--no-print") {
+            printMode = 0;
+        } else if (arg == "--save") {
+            savePath = argv[++i];
+        } else if (arg == "--range") {
+            hasRange = true;
+            minValue = atoi(argv[++i]);
+            maxValue = atoi(argv[++i]);
+        } else if (arg == "--approx") {
+            approxK = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed") {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            cerr << "Неизвестный параметр: " << arg << "\n";
+            return 1;
+        } else if (!inputPath.empty()) {
+            cerr << "Ошибка: лишний аргумент " << arg << " (файл уже задан: " << inputPath << ")\n";
+            return 1;
+        } else {
+            inputPath = arg;
+        }
+    }
+
+    // Матрица из файла выводится только по запросу
+    if (!inputPath.empty()) {
+        return analyzeFile(inputPath, printMode == 1, hasRange, minValue, maxValue, approxK);
+    }
+
     int M, N;
 
     // Ввод размеров матрицы с проверкой
@@ -22,50 +145,37 @@ int main() {
         return 1;
     }
 
-    // Инициализация генератора случайных чисел
-    srand(time(nullptr));
-
     // Создание матрицы M x N со случайными числами в диапазоне [100, 150]
-    vector<vector<int>> matrix(M, vector<int>(N));
-    for (int i = 0; i < M; ++i) {
-        for (int j = 0; j < N; ++j) {
-            matrix[i][j] = 100 + rand() % 51; // [100,150]
-        }
+    IntMatrix matrix = randomMatrix(M, N, 100, 150, seed);
+
+    if (!savePath.empty() && !saveMatrixBinary(savePath, matrix)) {
+        cerr << "Не удалось сохранить матрицу в " << savePath << "\n";
     }
 
     // Вывод матрицы
-    cout << "Матрица:\n";
-    for (const auto& row : matrix) {
-        for (int val : row)
-            cout << val << "\t";
-        cout << "\n";
+    if (printMode != 0) {
+        FastOutput& out = fastOutput();
+        out.text("Матрица:\n");
+        for (int i = 0; i < M; ++i) {
+            for (int val : rowView(matrix, i)) {
+                out.integer(val);
+                out.put('\t');
+            }
+            out.put('\n');
+        }
+        out.flush();
     }
 
-    // Подсчет частоты каждого числа
-    unordered_map<int, int> frequency;
-    for (const auto& row : matrix) {
-        for (int val : row)
-            ++frequency[val];
+    if (approxK > 0) {
+        printApproximate(approximateHeavyHitters(matrix.data.data(), matrix.data.size(), approxK));
+        return 0;
     }
 
-    // Поиск числа с максимальной частотой
-    int maxCount = 0;
-    int numberWithMaxCount = 0;
-    for (const auto& kv : frequency) {
-        if (kv.second > maxCount) {
-            maxCount = kv.second;
-            numberWithMaxCount = kv.first;
-        }
-    }
+    // Подсчет частоты каждого числа: значения заведомо лежат в [100, 150],
+    // поэтому счетчики - плоский массив, по одному на поток
+    FrequencyCounter frequency = countFrequencies(matrix.data.data(), matrix.data.size(), 100, 150);
 
-    // Вывод результата
-    if (maxCount == 1) {
-        cout << "Нет числа, которое встречается более одного раза.\n";
-    } else {
-        cout << "Число, встречающееся наибольшее количество раз: "
-             << numberWithMaxCount
-             << " (" << maxCount << " раз)\n";
-    }
+    printMostFrequent(frequency);
 
     return 0;
 }
@@ -117,18 +117,21 @@ int main() {
 */
 #include <iostream>
 #include <vector>
+#include <thread>
+#include <cstdlib>
 #include <unistd.h> // для usleep
 
+#include "life.h"
+#include "life_snapshot.h"
+#include "fast_output.h"
+
 using namespace std;
 
 // Размер поля 20x20
 const int SIZE = 20;
 
-// Игровое поле
-vector<vector<bool>> grid(SIZE, vector<bool>(SIZE, false));
-
 // Ставим глайдер в центр
-void setupGlider() {
+void setupGlider(LifeGrid& grid) {
     int center = SIZE/2;
     grid[center][center+1] = true;
     grid[center+1][center+2] = true;
@@ -138,42 +141,51 @@ void setupGlider() {
 }
 
 // Печатаем поле
-void print() {
+void print(const LifeGrid& grid) {
     system("clear");
-    for (auto row : grid) {
+    FastOutput& out = fastOutput();
+    for (const auto& row : grid) {
         for (bool cell : row)
-            cout << (cell ? "O" : " ");
-        cout << endl;
+            out.put(cell ? 'O' : ' ');
+        out.put('\n');
     }
+    out.flush();
+    cout.flush(); // кадр должен появиться до паузы
 }
 
-// Считаем соседей
-int countNeighbors(int x, int y) {
-    int count = 0;
-    for (int i = -1; i <= 1; i++)
-        for (int j = -1; j <= 1; j++)
-            if (i || j) // не считаем саму клетку
-                count += grid[(x+i+SIZE)%SIZE][(y+j+SIZE)%SIZE];
-    return count;
-}
-
-// Обновляем состояние
-void update() {
-    auto newGrid = grid;
-    for (int i = 0; i < SIZE; i++)
-        for (int j = 0; j < SIZE; j++) {
-            int n = countNeighbors(i, j);
-            if (grid[i][j]) newGrid[i][j] = (n == 2 || n == 3);
-            else newGrid[i][j] = (n == 3);
+// Моделирование и вывод - в разных потоках: поток моделирования публикует
+// поколения (life_snapshot.h) раз в 200ms независимо от вывода, главный
+// поток выводит последнее опубликованное поколение (если вывод не успевает,
+// промежуточные поколения пропускаются).
+// Запуск: laba6_13 [ПОКОЛЕНИЙ] - без аргумента поле обновляется бесконечно,
+// с аргументом программа завершается после вывода последнего поколения
+// (нужно, например, чтобы профилирующая сборка записала отчет)
+int main(int argc, char* argv[]) {
+    setupFastOutput();
+    long long generations = argc > 1 ? atoll(argv[1]) : -1;
+    LifeGrid grid(SIZE, vector<bool>(SIZE, false));
+    setupGlider(grid);
+    LifeSnapshotSlot world(grid);
+
+    thread simulation([&]() {
+        while (generations < 0 || world.generation() < generations) {
+            usleep(200000);
+            world.step();
         }
-    grid = newGrid;
-}
-
-int main() {
-    setupGlider();
-    while (true) {
-        print();
-        update();
-        usleep(200000); // 200ms задержка
+    });
+
+    long long shown = -1; // последнее выведенное поколение
+    while (generations < 0 || shown < generations) {
+        if (world.generation() != shown) {
+            // Пустой View - все закрепления заняты; кадр выводится в следующий раз
+            LifeSnapshotSlot::View view = world.acquire();
+            if (view) {
+                print(view.grid());
+                shown = view.generation();
+            }
+        }
+        usleep(10000);
     }
+    simulation.join();
+    return 0;
 }
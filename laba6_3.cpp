@@ -1,171 +1,69 @@
 #include <iostream>
 #include <vector>
-#include <iomanip>
 #include <cmath>
+#include <string>
 
-using namespace std;
+#include "linear_solvers.h"
+#include "fixed_size_solvers.h"
+#include "dominance_reorder.h"
+#include "fast_output.h"
 
-const double EPSILON = 1e-6;
+using namespace std;
 
 // Функция для вывода матрицы
 void printMatrix(const vector<vector<double>>& matrix, const string& title) {
-    cout << title << ":\n";
+    FastOutput& out = fastOutput();
+    out.text(title);
+    out.text(":\n");
     for (const auto& row : matrix) {
         for (double val : row) {
-            cout << setw(10) << fixed << setprecision(4) << val << " ";
-        }
-        cout << endl;
-    }
-    cout << endl;
-}
-
-// LU-разложение матрицы
-void LUDecomposition(const vector<vector<double>>& A,
-                     vector<vector<double>>& L,
-                     vector<vector<double>>& U) {
-    int n = A.size();
-    L = vector<vector<double>>(n, vector<double>(n, 0));
-    U = vector<vector<double>>(n, vector<double>(n, 0));
-
-    for (int i = 0; i < n; i++) {
-        // Верхняя треугольная матрица U
-        for (int k = i; k < n; k++) {
-            double sum = 0;
-            for (int j = 0; j < i; j++) {
-                sum += L[i][j] * U[j][k];
-            }
-            U[i][k] = A[i][k] - sum;
-        }
-
-        // Нижняя треугольная матрица L
-        for (int k = i; k < n; k++) {
-            if (i == k) {
-                L[i][i] = 1;
-            } else {
-                double sum = 0;
-                for (int j = 0; j < i; j++){
-                    sum += L[k][j] * U[j][i];
-                }
-                L[k][i] = (A[k][i] - sum) / U[i][i];
-            }
-        }
-    }
-}
-
-// Прямая подстановка Ly = b
-vector<double> ForwardSubstitution(const vector<vector<double>>& L,
-                                  const vector<double>& b) {
-    int n = L.size();
-    vector<double> y(n, 0);
-
-    for (int i = 0; i < n; i++) {
-        double sum = 0;
-        for (int j = 0; j < i; j++) {
-            sum += L[i][j] * y[j];
-        }
-        y[i] = (b[i] - sum) / L[i][i];
-    }
-
-    return y;
-}
-
-// Обратная подстановка Ux = y
-vector<double> BackwardSubstitution(const vector<vector<double>>& U,
-                                    const vector<double>& y) {
-    int n = U.size();
-    vector<double> x(n, 0);
-
-    for (int i = n - 1; i >= 0; i--) {
-        double sum = 0;
-        for (int j = i + 1; j < n; j++) {
-            sum += U[i][j] * x[j];
-        }
-        x[i] = (y[i] - sum) / U[i][i];
-    }
-
-    return x;
-}
-
-// Вычисление невязки
-vector<double> calculateResidual(const vector<vector<double>>& A,
-                                const vector<double>& b,
-                                const vector<double>& x) {
-    int n = A.size();
-    vector<double> residual(n, 0);
-
-    for (int i = 0; i < n; i++) {
-        double sum = 0;
-        for (int j = 0; j < n; j++) {
-            sum += A[i][j] * x[j];
+            out.fixed(val, 10, 4);
+            out.put(' ');
         }
-        residual[i] = b[i] - sum;
+        out.put('\n');
     }
-
-    return residual;
-}
-
-// Метод Зейделя для решения системы линейных уравнений
-vector<double> SeidelMethod(const vector<vector<double>>& A,
-                           const vector<double>& b,
-                           double epsilon = EPSILON,
-                           int maxIterations = 1000) {
-    int n = A.size();
-    vector<double> x(n, 0.0);//текущее приближение
-    vector<double> x_prev(n, 0.0);//предыдущее приближение
-    int iteration = 0;//счетчик итераций
-    double error;
-
-    do {
-        x_prev = x;
-        for (int i = 0; i < n; i++) {
-            double sum = 0.0;
-            for (int j = 0; j < n; j++) {
-                if (j != i) {
-                    sum += A[i][j] * x[j];
-                }
-            }
-            x[i] = (b[i] - sum) / A[i][i];
-        }
-
-        // Вычисление ошибки
-        error = 0.0;
-        for (int i = 0; i < n; i++) {
-            error = max(error, abs(x[i] - x_prev[i]));
-        }
-        iteration++;
-    } while (error > epsilon && iteration < maxIterations); // Условие продолжения
-
-    cout << "Метод Зейделя сошелся за " << iteration << " итераций\n";
-    return x;
+    out.put('\n');
+    out.flush();
 }
 
 // Вывод результатов в таблицу
 void printResultsTable(const vector<double>& x,
                        const vector<double>& residual,
                        const string& methodName) {
-    cout << "\nРезультаты решения методом " << methodName << ":\n";
-    cout << "+-----+-----------+-----------+-----------+-----------+\n";
-    cout << "|  N  |    x1     |    x2     |    x3     |    x4     |\n";
-    cout << "+-----+-----------+-----------+-----------+-----------+\n";
-
-    cout << "| " << setw(3) << 1;
-    for (int j = 0; j < 4; j++) {
-        cout << " | " << setw(9) << fixed << setprecision(6) << x[j];
+    int n = x.size();
+
+    // Граница таблицы и заголовок на n неизвестных
+    string border = "+-----+";
+    string header = "|  N  |";
+    for (int j = 0; j < n; j++) {
+        string name = "x" + to_string(j + 1);
+        border += "-----------+";
+        header += "    " + name + string(max(1, 7 - (int)name.size()), ' ') + "|";
     }
-    cout << " |\n";
 
-    // Максимальная по модулю невязка
-    double max_residual = 0;
-    for(double r : residual) {
-        if (fabs(r) > max_residual) {
-            max_residual = fabs(r);
-        }
+    FastOutput& out = fastOutput();
+    out.text("\nРезультаты решения методом " + methodName + ":\n");
+    out.text(border + "\n");
+    out.text(header + "\n");
+    out.text(border + "\n");
+
+    out.text("|   1");
+    for (int j = 0; j < n; j++) {
+        out.text(" | ");
+        out.fixed(x[j], 9, 6);
     }
-    cout << "+-----+-----------+-----------+-----------+-----------+\n";
-    cout << "Максимальная невязка: " << scientific << setprecision(2) << max_residual << "\n\n";
+    out.text(" |\n");
+
+    out.text(border + "\n");
+    out.text("Максимальная невязка: ");
+    out.scientific(maxResidual(residual), 2);
+    out.text("\n\n");
+    out.flush();
 }
 
 int main() {
+    setupFastOutput();
+
     // Преобразованная система с диагональным преобладанием
     vector<vector<double>> A = {
         {18.0,  -0.04,  0.21,  -0.89},
@@ -200,5 +98,82 @@ int main() {
     vector<double> residual_seidel = calculateResidual(A, b, x_seidel);
     printResultsTable(x_seidel, residual_seidel, "Зейделя");
 
+    // 3. Решение методом LU-разложения смешанной точности
+    vector<double> x_mixed;
+    int refinements = MixedPrecisionLU(A, b, x_mixed);
+    if (refinements >= 0) {
+        cout << "Уточнение смешанной точности сошлось за " << refinements << " итераций\n";
+    } else {
+        cout << "Уточнение смешанной точности не сошлось, система решена в double\n";
+    }
+    vector<double> residual_mixed = calculateResidual(A, b, x_mixed);
+    printResultsTable(x_mixed, residual_mixed, "LU-разложения смешанной точности");
+
+    // 4. Автоматический выбор метода по структуре матрицы
+    string autoMethod;
+    vector<double> x_auto = SolveAuto(A, b, &autoMethod);
+    cout << "Автоматически выбран метод: " << autoMethod << "\n";
+    vector<double> residual_auto = calculateResidual(A, b, x_auto);
+    printResultsTable(x_auto, residual_auto, "автоматического выбора");
+
+    // 5. Решение системы фиксированного размера 4x4 без выделений памяти
+    Matrix<4> A4;
+    Vector<4> b4, x4;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            A4[i][j] = A[i][j];
+        }
+        b4[i] = b[i];
+    }
+    if (SolveFixed(A4, b4, x4)) {
+        vector<double> x_fixed(x4.v, x4.v + 4);
+        vector<double> residual_fixed = calculateResidual(A, b, x_fixed);
+        printResultsTable(x_fixed, residual_fixed, "LU-разложения фиксированного размера");
+    }
+
+    // 6. Та же система с переставленными строками: преобладание находится автоматически
+    vector<vector<double>> A_shuffled = {A[2], A[0], A[3], A[1]};
+    vector<double> b_shuffled = {b[2], b[0], b[3], b[1]};
+    string reorderMethod;
+    ReorderResult reorder;
+    vector<double> x_reordered = SolveReordered(A_shuffled, b_shuffled, &reorderMethod, &reorder);
+    cout << "Перестановка строк к диагональному преобладанию:";
+    for (int row : reorder.rowOf) cout << " " << row + 1;
+    cout << "\nОценка спектрального радиуса итерации Зейделя: " << reorder.spectralRadius
+         << ", прогноз итераций: " << reorder.predictedIterations << "\n";
+    // Для систем меньше 6x6 бюджет Зейделя - одна итерация (см. SolveReordered),
+    // поэтому здесь выбирается LU
+    cout << "Выбран метод: " << reorderMethod << "\n";
+    vector<double> residual_reordered = calculateResidual(A_shuffled, b_shuffled, x_reordered);
+    printResultsTable(x_reordered, residual_reordered, "с автоматической перестановкой");
+
+    // 7. Большая система с переставленными строками: здесь Зейдель дешевле LU
+    const int BIG = 60;
+    vector<vector<double>> A_big(BIG, vector<double>(BIG));
+    vector<double> b_big(BIG);
+    for (int i = 0; i < BIG; i++) {
+        double rowSum = 0;
+        for (int j = 0; j < BIG; j++) {
+            A_big[i][j] = sin(1.0 + i * BIG + j); // детерминированные "случайные" числа
+            if (j != i) rowSum += fabs(A_big[i][j]);
+        }
+        A_big[i][i] = rowSum + 1.0;
+        b_big[i] = cos(1.0 + i);
+    }
+    // Строка i переходит на место (7 i) mod 60 - преобладание теряется
+    vector<vector<double>> A_big_shuffled(BIG);
+    vector<double> b_big_shuffled(BIG);
+    for (int i = 0; i < BIG; i++) {
+        A_big_shuffled[(7 * i) % BIG] = A_big[i];
+        b_big_shuffled[(7 * i) % BIG] = b_big[i];
+    }
+    ReorderResult bigReorder;
+    vector<double> x_big = SolveReordered(A_big_shuffled, b_big_shuffled, &reorderMethod, &bigReorder);
+    cout << "Система " << BIG << "x" << BIG << " с переставленными строками: выбран метод "
+         << reorderMethod << ", прогноз итераций " << bigReorder.predictedIterations
+         << ", выполнено " << bigReorder.seidelIterations << "\n";
+    cout << "Максимальная невязка: "
+         << maxResidual(calculateResidual(A_big_shuffled, b_big_shuffled, x_big)) << "\n";
+
     return 0;
 }
@@ -0,0 +1,608 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+
+#include "linear_solvers.h"
+#include "fixed_size_solvers.h"
+#include "out_of_core_lu.h"
+#include "dominance_reorder.h"
+#include "incremental_solver.h"
+#include "hash_mix.h"
+
+using namespace std;
+
+// Бенчмарк и проверка точности методов решения СЛАУ.
+// Генерирует системы разных классов и размеров, решает каждую всеми
+// методами и выводит время, GFLOP/s, число итераций и максимальную невязку
+// в машиночитаемом виде (CSV или JSON Lines).
+//
+// Классы систем: diag, spd, banded, tridiag, permuted, random.
+// Запуск: laba6_3_bench [--max-n N] [--sizes 16,64,...] [--classes diag,spd,...]
+//                       [--seed S] [--format csv|json] [--batch COUNT]
+//                       [--out-of-core N [--tile T] [--memory MB] [--dir PATH]]
+// С --batch измеряются пакеты из COUNT малых систем 2x2 .. 8x8.
+// С --out-of-core решается одна система порядка N с диагональным преобладанием
+// плиточным LU во внешней памяти: в ОЗУ не больше MB мегабайт плиток.
+// С --incremental UPDATES в системе с диагональным преобладанием каждого размера
+// UPDATES раз меняется один коэффициент, и система решается заново: с нуля LU,
+// через IncrementalSolver (LU + Вудбери) и методом Зейделя с теплым стартом.
+
+using DenseMatrix = vector<vector<double>>;
+
+// Результат одного решателя
+struct SolverResult {
+    vector<double> x;
+    int iterations = 0;   // итерации (0 - прямой метод)
+    double flops = 0;     // число операций с плавающей точкой
+    string method;        // выбранный путь (auto, reordered; пусто - имя решателя)
+    int predictedIterations = -1; // прогноз итераций Зейделя (reordered; -1 - нет)
+};
+
+struct Solver {
+    string name;
+    function<SolverResult(const DenseMatrix&, const vector<double>&)> solve;
+};
+
+// =============================================
+//          Генерация тестовых систем
+// =============================================
+
+// Матрица со строгим диагональным преобладанием
+DenseMatrix generateDiagonallyDominant(int n, mt19937_64& gen) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    DenseMatrix A(n, vector<double>(n));
+    for (int i = 0; i < n; i++) {
+        double rowSum = 0;
+        for (int j = 0; j < n; j++) {
+            A[i][j] = dis(gen);
+            if (j != i) rowSum += fabs(A[i][j]);
+        }
+        A[i][i] = rowSum + 1.0;
+    }
+    return A;
+}
+
+// Симметричная положительно определенная матрица
+// (симметричная с положительной диагональю и строгим преобладанием)
+DenseMatrix generateSPD(int n, mt19937_64& gen) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    DenseMatrix A(n, vector<double>(n));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < i; j++) {
+            A[i][j] = A[j][i] = dis(gen);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        double rowSum = 0;
+        for (int j = 0; j < n; j++) {
+            if (j != i) rowSum += fabs(A[i][j]);
+        }
+        A[i][i] = rowSum + 1.0;
+    }
+    return A;
+}
+
+// Ленточная матрица с полушириной ленты bandwidth и диагональным преобладанием
+DenseMatrix generateBanded(int n, mt19937_64& gen, int bandwidth = 3) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    DenseMatrix A(n, vector<double>(n, 0.0));
+    for (int i = 0; i < n; i++) {
+        double rowSum = 0;
+        for (int j = max(0, i - bandwidth); j <= min(n - 1, i + bandwidth); j++) {
+            if (j == i) continue;
+            A[i][j] = dis(gen);
+            rowSum += fabs(A[i][j]);
+        }
+        A[i][i] = rowSum + 1.0;
+    }
+    return A;
+}
+
+// Случайная плотная матрица без какой-либо структуры
+DenseMatrix generateRandom(int n, mt19937_64& gen) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    DenseMatrix A(n, vector<double>(n));
+    for (auto& row : A) {
+        for (double& val : row) {
+            val = dis(gen);
+        }
+    }
+    return A;
+}
+
+// Матрица с диагональным преобладанием и перемешанными строками:
+// преобладание есть, но его нужно найти перестановкой
+DenseMatrix generatePermuted(int n, mt19937_64& gen) {
+    DenseMatrix A = generateDiagonallyDominant(n, gen);
+    shuffle(A.begin(), A.end(), gen);
+    return A;
+}
+
+DenseMatrix generateSystem(const string& kind, int n, mt19937_64& gen) {
+    if (kind == "diag") return generateDiagonallyDominant(n, gen);
+    if (kind == "permuted") return generatePermuted(n, gen);
+    if (kind == "spd") return generateSPD(n, gen);
+    if (kind == "banded") return generateBanded(n, gen);
+    if (kind == "tridiag") return generateBanded(n, gen, 1);
+    return generateRandom(n, gen);
+}
+
+// Классы, которые понимает generateSystem
+const vector<string> SYSTEM_CLASSES = {"diag", "spd", "banded", "tridiag", "permuted", "random"};
+
+// =============================================
+//               Список решателей
+// =============================================
+
+// Операции ленточного LU с подстановками; у края матрицы лента обрезается
+double bandedLUFlops(int n, int kl, int ku) {
+    double flops = 0;
+    for (int k = 0; k < n; k++) {
+        double rows = min(kl, n - 1 - k);
+        double cols = min(ku, n - 1 - k);
+        flops += rows * (2.0 * cols + 1.0);
+    }
+    return flops + 2.0 * n * (kl + ku + 1);
+}
+
+// Операции SolveReordered: масштабирование, оценка спектрального радиуса
+// (шаг - как итерация Зейделя), итерации Зейделя и LU, если выбран он
+double reorderedFlops(int n, const string& method, const ReorderResult& info) {
+    double dn = n;
+    double flops = info.seidelIterations * 2.0 * dn * dn;
+    if (method != "lu") flops += 2.0 * dn * dn + SPECTRAL_ITERATIONS * 2.0 * dn * dn;
+    if (method != "reordered_seidel") flops += 2.0 / 3.0 * dn * dn * dn + 2.0 * dn * dn;
+    return flops;
+}
+
+// Операции пути, выбранного SolveAuto (и неудачной попытки Зейделя)
+double autoFlops(const DenseMatrix& A, const string& method, int seidelIterations) {
+    double n = A.size();
+    double flops = seidelIterations * 2.0 * n * n;
+    if (method == "thomas") {
+        flops += 8.0 * n;
+    } else if (method == "banded_lu") {
+        MatrixStructure s = analyzeMatrix(A);
+        flops += bandedLUFlops(A.size(), s.lowerBandwidth, s.upperBandwidth);
+    } else if (method == "cholesky") {
+        flops += 1.0 / 3.0 * n * n * n + 2.0 * n * n;
+    } else if (method == "lu") {
+        flops += 2.0 / 3.0 * n * n * n + 2.0 * n * n;
+    }
+    return flops;
+}
+
+vector<Solver> makeSolvers() {
+    vector<Solver> solvers;
+
+    solvers.push_back({"lu", [](const DenseMatrix& A, const vector<double>& b) {
+        double n = A.size();
+        DenseMatrix L, U;
+        LUDecomposition(A, L, U);
+        SolverResult r;
+        r.x = BackwardSubstitution(U, ForwardSubstitution(L, b));
+        r.flops = 2.0 / 3.0 * n * n * n + 2.0 * n * n;
+        return r;
+    }});
+
+    solvers.push_back({"seidel", [](const DenseMatrix& A, const vector<double>& b) {
+        double n = A.size();
+        SolverResult r;
+        r.x.assign(A.size(), 0.0);
+        r.iterations = SeidelIterations(A, b, r.x);
+        r.flops = r.iterations * 2.0 * n * n;
+        return r;
+    }});
+
+    solvers.push_back({"mixed_lu", [](const DenseMatrix& A, const vector<double>& b) {
+        double n = A.size();
+        SolverResult r;
+        r.iterations = MixedPrecisionLU(A, b, r.x);
+        // Разложение во float, затем на каждой итерации невязка и подстановки
+        r.flops = 2.0 / 3.0 * n * n * n + max(r.iterations, 1) * 4.0 * n * n;
+        if (r.iterations < 0) r.flops += 2.0 / 3.0 * n * n * n;
+        return r;
+    }});
+
+    solvers.push_back({"banded_lu", [](const DenseMatrix& A, const vector<double>& b) {
+        MatrixStructure s = analyzeMatrix(A);
+        BandMatrix band = toBandMatrix(A, s.lowerBandwidth, s.upperBandwidth);
+        SolverResult r;
+        if (BandedLUDecomposition(band)) {
+            r.x = BandedLUSolve(band, b);
+        } else {
+            r.x.assign(A.size(), NAN);
+        }
+        r.flops = bandedLUFlops(A.size(), s.lowerBandwidth, s.upperBandwidth);
+        return r;
+    }});
+
+    // Для несимметричных и не положительно определенных матриц решение
+    // помечается как NaN
+    solvers.push_back({"cholesky", [](const DenseMatrix& A, const vector<double>& b) {
+        double n = A.size();
+        PackedLower L;
+        SolverResult r;
+        if (analyzeMatrix(A).symmetric && CholeskyDecomposition(A, L)) {
+            r.x = CholeskySolve(L, b);
+            r.flops = 1.0 / 3.0 * n * n * n + 2.0 * n * n;
+        } else {
+            r.x.assign(A.size(), NAN);
+        }
+        return r;
+    }});
+
+    // Автоматический выбор; время включает анализ структуры (O(n^2)).
+    // Итерации и операции - выбранного пути вместе с неудачной попыткой Зейделя
+    solvers.push_back({"auto", [](const DenseMatrix& A, const vector<double>& b) {
+        SolverResult r;
+        r.x = SolveAuto(A, b, &r.method, &r.iterations);
+        r.flops = autoFlops(A, r.method, r.iterations);
+        return r;
+    }});
+
+    // Перестановка к диагональному преобладанию, затем Зейдель или LU по
+    // оценке спектрального радиуса; время включает перестановку и оценку
+    solvers.push_back({"reordered", [](const DenseMatrix& A, const vector<double>& b) {
+        SolverResult r;
+        ReorderResult info;
+        r.x = SolveReordered(A, b, &r.method, &info);
+        r.iterations = info.seidelIterations;
+        r.predictedIterations = info.predictedIterations;
+        r.flops = reorderedFlops(A.size(), r.method, info);
+        return r;
+    }});
+
+    return solvers;
+}
+
+// =============================================
+//               Основная программа
+// =============================================
+
+// Одна строка результатов в формате CSV или JSON Lines
+// (method - путь, выбранный решателем; пусто - совпадает с solver;
+// predicted - прогноз итераций, -1 - прогноза нет)
+void printRecord(const string& format, const string& kind, int n, const string& solver,
+                 double seconds, double gflops, int iterations, double residual,
+                 const string& method = "", int predicted = -1) {
+    const string& path = method.empty() ? solver : method;
+    if (format == "json") {
+        cout << "{\"class\":\"" << kind << "\",\"n\":" << n
+             << ",\"solver\":\"" << solver << "\",\"method\":\"" << path
+             << "\",\"seconds\":" << seconds
+             << ",\"gflops\":" << gflops << ",\"iterations\":" << iterations
+             << ",\"predicted_iterations\":";
+        if (predicted >= 0) cout << predicted;
+        else cout << "null";
+        cout << ",\"max_residual\":";
+        // NaN/Inf не допускаются в JSON
+        if (isfinite(residual)) cout << residual;
+        else cout << "null";
+        cout << "}\n";
+    } else {
+        cout << kind << "," << n << "," << solver << "," << path << "," << seconds << ","
+             << gflops << "," << iterations << ",";
+        if (predicted >= 0) cout << predicted;
+        cout << ",";
+        if (isnan(residual)) cout << "nan";
+        else cout << residual;
+        cout << "\n";
+    }
+    cout.flush();
+}
+
+// Пакет из count малых систем размера N: поштучно через SolveFixed,
+// пакетно через SolveBatch и для сравнения общим LUDecomposition
+template <int N>
+void benchBatch(size_t count, unsigned long long seed, const string& format) {
+    mt19937_64 gen(seed + N);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    vector<Matrix<N>> A(count);
+    vector<Vector<N>> b(count), x(count);
+    for (size_t s = 0; s < count; s++) {
+        for (int i = 0; i < N; i++) {
+            double rowSum = 0;
+            for (int j = 0; j < N; j++) {
+                A[s][i][j] = dis(gen);
+                if (j != i) rowSum += fabs(A[s][i][j]);
+            }
+            A[s][i][i] = rowSum + 1.0;
+            b[s][i] = dis(gen);
+        }
+    }
+
+    // Максимальная невязка по всем системам пакета
+    auto batchResidual = [&]() {
+        double worst = 0;
+        for (size_t s = 0; s < count; s++) {
+            for (int i = 0; i < N; i++) {
+                double sum = 0;
+                for (int j = 0; j < N; j++) sum += A[s][i][j] * x[s][j];
+                double r = fabs(b[s][i] - sum);
+                if (isnan(r)) return r;
+                worst = max(worst, r);
+            }
+        }
+        return worst;
+    };
+    double flops = count * (2.0 / 3.0 * N * N * N + 2.0 * N * N);
+    auto report = [&](const string& name, chrono::steady_clock::time_point start) {
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printRecord(format, "batch", N, name, seconds, seconds > 0 ? flops / seconds / 1e9 : 0.0,
+                    0, batchResidual());
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (size_t s = 0; s < count; s++) {
+        if (!SolveFixed(A[s], b[s], x[s])) {
+            for (int i = 0; i < N; i++) x[s][i] = NAN;
+        }
+    }
+    report("fixed", start);
+
+    start = chrono::steady_clock::now();
+    SolveBatch(A.data(), b.data(), x.data(), count);
+    report("fixed_batch", start);
+
+    start = chrono::steady_clock::now();
+    for (size_t s = 0; s < count; s++) {
+        DenseMatrix M(N, vector<double>(N)), L, U;
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) M[i][j] = A[s][i][j];
+        }
+        LUDecomposition(M, L, U);
+        vector<double> rhs(b[s].v, b[s].v + N);
+        vector<double> sol = BackwardSubstitution(U, ForwardSubstitution(L, rhs));
+        for (int i = 0; i < N; i++) x[s][i] = sol[i];
+    }
+    report("lu", start);
+}
+
+template <int... Sizes>
+void benchBatchSizes(size_t count, unsigned long long seed, const string& format) {
+    (benchBatch<Sizes>(count, seed, format), ...);
+}
+
+// Элемент системы для --out-of-core: вычисляется по (i, j), а не хранится,
+// чтобы невязку можно было посчитать без второй копии матрицы.
+// Недиагональные элементы из [-1, 1], на диагонали n - строгое преобладание
+double outOfCoreElement(int i, int j, int n, unsigned long long seed) {
+    if (i == j) return n;
+    uint64_t h = splitMix64(seed ^ (static_cast<uint64_t>(i) * 0x9e3779b97f4a7c15ull + static_cast<uint64_t>(j)));
+    return static_cast<double>(h >> 11) * 0x1.0p-52 - 1.0;
+}
+
+void benchOutOfCore(int n, int tile, double memoryMB, const string& dir,
+                    unsigned long long seed, const string& format) {
+    size_t tileBytes = static_cast<size_t>(tile) * tile * sizeof(double);
+    size_t poolTiles = max<size_t>(4, static_cast<size_t>(memoryMB * 1024 * 1024 / tileBytes));
+    OutOfCoreMatrix M(dir + "/laba6_3_bench.tiles", n, tile, poolTiles);
+    if (!M.ok()) {
+        cerr << "Ошибка: не удалось создать файл плиток в " << dir << "\n";
+        return;
+    }
+
+    vector<double> b(n);
+    for (int i = 0; i < n; i++) b[i] = outOfCoreElement(i, n, n, seed);
+
+    auto start = chrono::steady_clock::now();
+    M.fill([n, seed](int i, int j) { return outOfCoreElement(i, j, n, seed); });
+    bool ok = M.factorize();
+    vector<double> x = ok ? M.solve(b) : vector<double>(n, NAN);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Невязка по строкам, элементы вычисляются заново
+    vector<double> residual(n);
+    parallelFor(0, n, max(1u, thread::hardware_concurrency()), [&](int i) {
+        double sum = 0;
+        for (int j = 0; j < n; j++) sum += outOfCoreElement(i, j, n, seed) * x[j];
+        residual[i] = b[i] - sum;
+    });
+
+    double flops = 2.0 / 3.0 * n * n * static_cast<double>(n) + 2.0 * n * static_cast<double>(n);
+    printRecord(format, "out_of_core", n, "tiled_lu", seconds, seconds > 0 ? flops / seconds / 1e9 : 0.0,
+                0, maxResidual(residual));
+    TilePoolStats stats = M.statistics();
+    cerr << "Пул: " << poolTiles << " плиток, попаданий " << stats.hits << ", чтений по требованию "
+         << stats.misses << ", подкачано " << stats.prefetched << ", записей " << stats.writes << "\n";
+}
+
+void benchIncremental(int n, int updates, unsigned long long seed, const string& format) {
+    mt19937_64 gen(seed + n);
+    DenseMatrix A = generateDiagonallyDominant(n, gen);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    vector<double> b(n);
+    for (double& val : b) val = dis(gen);
+
+    // Изменения: внедиагональный коэффициент в [-1, 1], преобладание сохраняется
+    // с запасом, потому что диагональ больше суммы модулей строки на 1
+    vector<int> rows(updates), cols(updates);
+    vector<double> values(updates);
+    for (int u = 0; u < updates; u++) {
+        rows[u] = gen() % n;
+        cols[u] = (rows[u] + 1 + gen() % (n - 1)) % n;
+        values[u] = dis(gen) * 0.5;
+    }
+
+    double luFlops = 2.0 / 3.0 * n * n * static_cast<double>(n) + 2.0 * n * static_cast<double>(n);
+    auto report = [&](const string& name, chrono::steady_clock::time_point start, double flops,
+                      int iterations, const DenseMatrix& M, const vector<double>& x) {
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printRecord(format, "incremental", n, name, seconds, seconds > 0 ? flops / seconds / 1e9 : 0.0,
+                    iterations, maxResidual(calculateResidual(M, b, x)));
+    };
+
+    // С нуля: LUDecomposition после каждого изменения
+    DenseMatrix M = A;
+    vector<double> x;
+    auto start = chrono::steady_clock::now();
+    for (int u = 0; u < updates; u++) {
+        M[rows[u]][cols[u]] = values[u];
+        DenseMatrix L, U;
+        LUDecomposition(M, L, U);
+        x = BackwardSubstitution(U, ForwardSubstitution(L, b));
+    }
+    report("lu_full", start, updates * luFlops, 0, M, x);
+
+    IncrementalSolver woodbury(A);
+    woodbury.solve(b);
+    start = chrono::steady_clock::now();
+    for (int u = 0; u < updates; u++) {
+        woodbury.setCoefficient(rows[u], cols[u], values[u]);
+        woodbury.solve(b);
+    }
+    IncrementalStats ws = woodbury.statistics();
+    report("woodbury", start, ws.flops, static_cast<int>(ws.refactorizations), woodbury.matrix(),
+           woodbury.solution());
+
+    IncrementalSolver warm(A);
+    warm.solveSeidel(b);
+    start = chrono::steady_clock::now();
+    int iterations = 0;
+    for (int u = 0; u < updates; u++) {
+        warm.setCoefficient(rows[u], cols[u], values[u]);
+        warm.solveSeidel(b);
+        iterations += warm.statistics().lastSeidelIterations;
+    }
+    IncrementalStats ss = warm.statistics();
+    report("seidel_warm", start, iterations * 2.0 * n * n, iterations, warm.matrix(), warm.solution());
+
+    cerr << "n = " << n << ": Вудбери сэкономил " << ws.savedFraction() * 100 << "% операций ("
+         << ws.refactorizations << " разложений на " << ws.updates << " изменений), "
+         << "Зейдель с теплым стартом - " << ss.savedFraction() * 100 << "% (итераций от нуля: "
+         << ss.coldSeidelIterations << ")\n";
+}
+
+vector<string> splitList(const string& s) {
+    vector<string> items;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == string::npos) comma = s.size();
+        if (comma > start) items.push_back(s.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return items;
+}
+
+int main(int argc, char* argv[]) {
+    int maxN = 1024;
+    unsigned long long seed = 42;
+    string format = "csv";
+    vector<string> classes = SYSTEM_CLASSES;
+    vector<int> sizes;
+    size_t batchCount = 0; // число малых систем в пакетном режиме
+    int outOfCoreN = 0;    // порядок системы во внешней памяти
+    int tile = 256;
+    double memoryMB = 256;
+    string dir = ".";
+    int incrementalUpdates = 0; // изменений коэффициентов в режиме --incremental
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения\n";
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--max-n") {
+            maxN = atoi(value.c_str());
+        } else if (arg == "--sizes") {
+            for (const string& item : splitList(value)) sizes.push_back(atoi(item.c_str()));
+        } else if (arg == "--classes") {
+            classes = splitList(value);
+            for (const string& kind : classes) {
+                if (find(SYSTEM_CLASSES.begin(), SYSTEM_CLASSES.end(), kind) == SYSTEM_CLASSES.end()) {
+                    cerr << "Неизвестный класс системы: " << kind << "\n";
+                    return 1;
+                }
+            }
+        } else if (arg == "--seed") {
+            seed = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--format") {
+            format = value;
+        } else if (arg == "--batch") {
+            batchCount = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--out-of-core") {
+            outOfCoreN = atoi(value.c_str());
+        } else if (arg == "--tile") {
+            tile = max(1, atoi(value.c_str()));
+        } else if (arg == "--memory") {
+            memoryMB = atof(value.c_str());
+        } else if (arg == "--dir") {
+            dir = value;
+        } else if (arg == "--incremental") {
+            incrementalUpdates = atoi(value.c_str());
+        } else {
+            cerr << "Неизвестный параметр: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    // По умолчанию - удвоение размера от 16 до maxN (не более 16384)
+    if (sizes.empty()) {
+        for (int n = 16; n <= min(maxN, 16384); n *= 2) sizes.push_back(n);
+    }
+
+    vector<Solver> solvers = makeSolvers();
+
+    if (format == "csv") {
+        cout << "class,n,solver,method,seconds,gflops,iterations,predicted_iterations,max_residual\n";
+    }
+
+    // Пакетный режим: малые системы 2x2 .. 8x8 вместо больших
+    if (batchCount > 0) {
+        benchBatchSizes<2, 3, 4, 5, 6, 7, 8>(batchCount, seed, format);
+        return 0;
+    }
+
+    if (outOfCoreN > 0) {
+        benchOutOfCore(outOfCoreN, tile, memoryMB, dir, seed, format);
+        return 0;
+    }
+
+    if (incrementalUpdates > 0) {
+        for (int n : sizes) {
+            if (n > 1) benchIncremental(n, incrementalUpdates, seed, format);
+        }
+        return 0;
+    }
+
+    for (const string& kind : classes) {
+        for (int n : sizes) {
+            if (n <= 0) continue;
+            mt19937_64 gen(seed + n);
+            DenseMatrix A = generateSystem(kind, n, gen);
+            uniform_real_distribution<double> dis(-1.0, 1.0);
+            vector<double> b(n);
+            for (double& val : b) val = dis(gen);
+
+            double luSeconds = 0, mixedSeconds = 0;
+            for (const Solver& solver : solvers) {
+                auto start = chrono::steady_clock::now();
+                SolverResult r = solver.solve(A, b);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                if (solver.name == "lu") luSeconds = seconds;
+                if (solver.name == "mixed_lu") mixedSeconds = seconds;
+
+                double residual = maxResidual(calculateResidual(A, b, r.x));
+                double gflops = seconds > 0 ? r.flops / seconds / 1e9 : 0.0;
+                printRecord(format, kind, n, solver.name, seconds, gflops, r.iterations, residual, r.method,
+                            r.predictedIterations);
+            }
+            if (mixedSeconds > 0) {
+                cerr << kind << ", n = " << n << ": mixed_lu быстрее lu в " << luSeconds / mixedSeconds
+                     << " раз\n";
+            }
+        }
+    }
+
+    return 0;
+}
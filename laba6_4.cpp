@@ -1,10 +1,146 @@
 #include <iostream>
 #include <vector>
+#include <string>
 #include <algorithm>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "boa_moves.h"
+#include "matrix_gen.h"
+#include "fast_output.h"
 
 using namespace std;
 
-int main() {
+// Запуск:
+//   laba6_4                         - клетки вводятся с клавиатуры
+//   laba6_4 ФАЙЛ                    - пакетный режим: в каждой строке файла запрос
+//                                     "K c1 ... cK", ответы выводятся по строке на запрос
+//                                     (-1 - некорректный запрос)
+//   laba6_4 --check [COUNT] [--seed S] - сверка формулы с пошаговой симуляцией
+//                                     на COUNT случайных запросах
+
+// Пакетный режим: файл отображается в память, запросы решаются параллельно
+int answerFile(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Ошибка: не удалось открыть файл " << path << endl;
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        cerr << "Ошибка: не удалось получить размер файла " << path << endl;
+        close(fd);
+        return 1;
+    }
+    size_t fileSize = static_cast<size_t>(st.st_size);
+
+    vector<long long> answers;
+    if (fileSize > 0) {
+        void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            cerr << "Ошибка: не удалось отобразить файл в память" << endl;
+            close(fd);
+            return 1;
+        }
+        const char* text = static_cast<const char*>(mapped);
+        answers = answerBoaQueries(text, text + fileSize);
+        munmap(mapped, fileSize);
+    }
+    close(fd);
+
+    FastOutput& out = fastOutput();
+    long long invalid = 0;
+    for (long long moves : answers) {
+        if (moves < 0) invalid++;
+        out.integer(moves);
+        out.put('\n');
+    }
+    out.flush();
+    if (invalid > 0) {
+        cerr << "Некорректных запросов: " << invalid << endl;
+    }
+    return 0;
+}
+
+// Сверка advanceMoves с simulateMoves на случайных последовательностях клеток.
+// Расстояния - как малые (все случаи разгона и торможения), так и до 10^9.
+int checkAgainstSimulation(long long count, uint64_t seed) {
+    const int MAX_K = 16;
+    vector<int> lengths(count), smallGaps(count * MAX_K), largeGaps(count * MAX_K), kinds(count * MAX_K);
+    fillUniformInt(lengths.data(), lengths.size(), 1, MAX_K, seed);
+    fillUniformInt(smallGaps.data(), smallGaps.size(), 1, 200, seed + 1);
+    fillUniformInt(largeGaps.data(), largeGaps.size(), 1, 1000000000, seed + 2);
+    fillUniformInt(kinds.data(), kinds.size(), 0, 15, seed + 3);
+
+    for (long long q = 0; q < count; ++q) {
+        BoaState fast, reference;
+        long long cell = 0;
+        for (int i = 0; i < lengths[q]; ++i) {
+            size_t g = static_cast<size_t>(q) * MAX_K + i;
+            cell += kinds[g] == 0 ? largeGaps[g] : smallGaps[g];
+            long long expected = simulateMoves(reference, cell);
+            long long actual = advanceMoves(fast, cell);
+            if (expected != actual || reference.position != fast.position || reference.speed != fast.speed) {
+                cout << "Расхождение в запросе " << q << ", клетка " << cell << ": ходов "
+                     << actual << " вместо " << expected << endl;
+                return 1;
+            }
+        }
+    }
+    cout << "Проверено запросов: " << count << ", расхождений нет" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    setupFastOutput();
+
+    if (argc > 1) {
+        string mode = argv[1];
+        if (mode == "--check") {
+            long long count = 100000;
+            bool countGiven = false;
+            uint64_t seed = randomSeed();
+            for (int i = 2; i < argc; ++i) {
+                string arg = argv[i];
+                if (arg == "--seed") {
+                    if (i + 1 >= argc) {
+                        cerr << "Ошибка: у параметра " << arg << " нет значения\n";
+                        return 1;
+                    }
+                    seed = strtoull(argv[++i], nullptr, 10);
+                } else if (arg.size() > 1 && arg[0] == '-') {
+                    cerr << "Неизвестный параметр: " << arg << "\n";
+                    return 1;
+                } else if (countGiven) {
+                    cerr << "Ошибка: лишний аргумент " << arg << "\n";
+                    return 1;
+                } else {
+                    char* end = nullptr;
+                    count = strtoll(arg.c_str(), &end, 10);
+                    if (end == arg.c_str() || *end != '\0' || count <= 0) {
+                        cerr << "Ошибка: COUNT должно быть положительным числом, получено " << arg << "\n";
+                        return 1;
+                    }
+                    countGiven = true;
+                }
+            }
+            return checkAgainstSimulation(count, seed);
+        }
+        if (mode.size() > 1 && mode[0] == '-') {
+            cerr << "Неизвестный параметр: " << mode << "\n";
+            return 1;
+        }
+        if (argc > 2) {
+            cerr << "Ошибка: лишний аргумент " << argv[2] << " (файл уже задан: " << mode << ")\n";
+            return 1;
+        }
+        return answerFile(mode);
+    }
+
     // Вывод подсказки для ввода K
     cout << "Введите количество целевых клеток K:" << endl;
     int K;
@@ -15,23 +151,28 @@ int main() {
         cout << "Ошибка: K должно быть положительным числом" << endl;
         return 1;
     }
-    if (K > 1e4) {
-        cout << "Ошибка: K не может превышать 10000" << endl;
-        return 1;
-    }
 
     // Вывод подсказки для ввода клеток
     cout << "Введите клетки через пробел в порядке возрастания:" << endl;
-    vector<int> cells(K);
+    // Память растет по мере чтения, а не выделяется сразу на K клеток:
+    // огромное K с коротким вводом заканчивается сообщением об ошибке, а не bad_alloc
+    vector<long long> cells;
+    cells.reserve(min(K, 1 << 16));
     for (int i = 0; i < K; ++i) {
-        cin >> cells[i];
+        long long cell;
+        if (!(cin >> cell)) {
+            cout << "Ошибка ввода: введены некорректные данные или меньше K клеток (прочитано "
+                 << i << " из " << K << ")" << endl;
+            return 1;
+        }
+        cells.push_back(cell);
         // Проверка корректности клеток
         if (cells[i] < 1) {
             cout << "Ошибка: номер клетки не может быть меньше 1" << endl;
             return 1;
         }
-        if (cells[i] > 1e4) {
-            cout << "Ошибка: номер клетки не может превышать 10000" << endl;
+        if (cells[i] > BOA_MAX_CELL) {
+            cout << "Ошибка: номер клетки не может превышать " << BOA_MAX_CELL << endl;
             return 1;
         }
         // Проверка возрастания
@@ -41,33 +182,8 @@ int main() {
         }
     }
 
-    // Проверка на ошибки ввода
-    if (cin.fail()) {
-        cout << "Ошибка ввода: введены некорректные данные" << endl;
-        return 1;
-    }
-
-    int position = 1; // Начинаем с головы удава (клетка 1)
-    int speed = 0;     // Начальная скорость
-    int moves = 0;     // Счетчик ходов
-
-    for (int target : cells) {
-        while (position < target) {
-            // Вычисляем минимальную скорость для достижения цели
-            int required_speed = target - position;
-
-            // Оптимизируем скорость
-            if (speed < required_speed) {
-                speed++;
-            } else if (speed > required_speed) {
-                speed = max(speed - 1, 1);
-            }
-
-            // Перемещаем фишку
-            position += speed;
-            moves++;
-        }
-    }
+    // Ходы между соседними целями считаются по формуле, без симуляции
+    long long moves = countMoves(cells.data(), cells.size());
 
     // Вывод результата
     cout << "Минимальное количество ходов: " << moves << endl;
@@ -1,109 +1,161 @@
 #include <iostream>
 #include <vector>
-#include <climits>
-#include <random>
+#include <string>
+#include <cstdlib>
+
+#include "matrix_gen.h"
+#include "coin_flip.h"
+#include "coin_flip_exact.h"
+#include "fast_output.h"
 
 using namespace std;
 
-// Функция для проверки, является ли доска шахматной
-bool isChessboard(const vector<vector<int>>& board, int pattern) {
-    for (int i = 0; i < board.size(); ++i) {
-        for (int j = 0; j < board[0].size(); ++j) {
-            int expected = (i + j + pattern) % 2;
-            if (board[i][j] != expected) {
-                return false;
-            }
-        }
+// Вывод ответа жадного алгоритма
+void printResult(long long result) {
+    if (result == -1) {
+        cout << "Невозможно преобразовать доску в шахматный узор" << endl;
+    } else {
+        cout << "Минимальное количество ходов: " << result << endl;
     }
-    return true;
 }
 
-// Функция для переворота монеты
-void flipCoin(vector<vector<int>>& board, int i, int j) {
-    if (i >= 0 && i < board.size() && j >= 0 && j < board[0].size()) {
-        board[i][j] ^= 1; // Переворачиваем монету
+// Вывод точного минимума
+void printExact(const PackedBoard& board) {
+    ExactFlipResult result = exactMinFlips(board);
+    if (!result.complete) {
+        cout << "Точный минимум не найден: превышен бюджет состояний" << endl;
+    } else if (result.moves >= 0) {
+        cout << "Точный минимум ходов: " << result.moves
+             << " (просмотрено состояний: " << result.statesVisited << ")" << endl;
     }
 }
 
-// Функция для подсчета минимального количества ходов
-int minFlips(vector<vector<int>>& board) {
-    int n = board.size();
-    if (n == 0) return 0;
-    int m = board[0].size();
-
-    // Два возможных шахматных паттерна
-    int min_flips = INT_MAX;
-
-    for (int pattern = 0; pattern < 2; ++pattern) {
-        vector<vector<int>> temp = board;
-        int flips = 0;
-
-        // Пытаемся преобразовать доску в текущий паттерн
+// Сверка minFlipsBits с minFlips на count случайных досках разных размеров
+// (в том числе со строками длиннее одного слова)
+int checkAgainstGreedy(int count, uint64_t seed) {
+    vector<int> sizes(2 * count);
+    fillUniformInt(sizes.data(), sizes.size(), 1, 140, seed);
+    for (int t = 0; t < count; ++t) {
+        int n = sizes[2 * t] % 12 + 1;
+        int m = t % 2 ? sizes[2 * t + 1] : sizes[2 * t + 1] % 12 + 1;
+        vector<uint64_t> bits((static_cast<size_t>(n) * m + 63) / 64);
+        fillRandomBits(bits.data(), bits.size(), seed + t + 1, 1);
+
+        vector<vector<int>> board(n, vector<int>(m));
         for (int i = 0; i < n; ++i) {
             for (int j = 0; j < m; ++j) {
-                int expected = (i + j + pattern) % 2;
-                if (temp[i][j] != expected) {
-                    // Переворачиваем текущую монету и соседнюю (правую или нижнюю)
-                    flipCoin(temp, i, j);
-                    if (j + 1 < m) {
-                        flipCoin(temp, i, j + 1);
-                    } else if (i + 1 < n) {
-                        flipCoin(temp, i + 1, j);
-                    } else {
-                        // Невозможно сделать ход - паттерн недостижим
-                        flips = INT_MAX;
-                        break;
-                    }
-                    flips++;
-                }
+                board[i][j] = randomBit(bits, static_cast<size_t>(i) * m + j);
             }
-            if (flips == INT_MAX) break;
         }
-
-        if (flips < min_flips) {
-            min_flips = flips;
+        long long expected = minFlips(board);
+        long long actual = minFlipsBits(packBits(bits.data(), n, m));
+        if (expected != actual) {
+            cout << "Расхождение на доске " << n << "x" << m << ": " << actual
+                 << " вместо " << expected << endl;
+            return 1;
         }
     }
+    cout << "Проверено досок: " << count << ", расхождений нет" << endl;
+    return 0;
+}
 
-    return (min_flips == INT_MAX) ? -1 : min_flips;
+// Таблица: оптимален ли жадный ответ на досках всех размеров до maxSize x maxSize
+int reportGreedyOptimality(int maxSize, long long samples, uint64_t seed) {
+    cout << "Размер\tДосок\tОптимально\tНе решено\tПроверка\tКонтрпример (жадный / точный)" << endl;
+    for (int n = 1; n <= maxSize; ++n) {
+        for (int m = 1; m <= maxSize; ++m) {
+            GreedyReport report = checkGreedyOptimality(n, m, samples, seed);
+            cout << n << "x" << m << "\t" << report.boards << "\t" << report.optimal << "\t"
+                 << report.unknown << "\t" << (report.exhaustive ? "все доски" : "выборка");
+            if (report.optimal + report.unknown < report.boards) {
+                cout << "\t" << report.greedyMoves << " / " << report.exactMoves << ":";
+                for (int i = 0; i < n; ++i) {
+                    cout << " ";
+                    for (int j = 0; j < m; ++j) cout << ((report.counterexample >> (i * m + j)) & 1);
+                }
+            }
+            cout << endl;
+        }
+    }
+    return 0;
 }
 
-int main() {
-    // Инициализация генератора случайных чисел
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> dis(0, 1);
+// Запуск: laba6_5 [--seed S] [--no-print] [--exact] - при одном S доска одна и та же;
+//         с --no-print доска не выводится и не распаковывается (большие доски);
+//         с --exact дополнительно ищется точный минимум (доски до 56 клеток)
+//         laba6_5 --check [COUNT] [--seed S] - сверка битового решения с minFlips
+//         laba6_5 --report [SAMPLES] [--seed S] - оптимален ли жадный ответ
+//                  на досках до 6x6 (малые - полный перебор, остальные - выборка)
+int main(int argc, char* argv[]) {
+    setupFastOutput();
+
+    uint64_t seed = randomSeed();
+    bool printBoard = true;
+    bool exact = false;
+    int checkCount = 0;
+    long long reportSamples = 0;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--no-print") {
+            printBoard = false;
+        } else if (arg == "--check") {
+            checkCount = 10000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') checkCount = max(1, atoi(argv[++i]));
+        } else if (arg == "--exact") {
+            exact = true;
+        } else if (arg == "--report") {
+            reportSamples = 100;
+            if (i + 1 < argc && argv[i + 1][0] != '-') reportSamples = max(1LL, atoll(argv[++i]));
+        }
+    }
+    if (checkCount > 0) {
+        return checkAgainstGreedy(checkCount, seed);
+    }
+    if (reportSamples > 0) {
+        return reportGreedyOptimality(6, reportSamples, seed);
+    }
 
     // Размеры доски
     int n, m;
     cout << "Введите размеры доски N и M: ";
     cin >> n >> m;
 
-    // Создание и заполнение доски случайными значениями
+    // Создание и заполнение доски случайными значениями:
+    // по одному случайному биту на клетку
+    vector<uint64_t> bits((static_cast<size_t>(n) * m + 63) / 64);
+    fillRandomBits(bits.data(), bits.size(), seed);
+    if (!printBoard) {
+        PackedBoard packed = packBits(bits.data(), n, m);
+        printResult(minFlipsBits(packed));
+        if (exact) printExact(packed);
+        return 0;
+    }
+
     vector<vector<int>> board(n, vector<int>(m));
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < m; ++j) {
-            board[i][j] = dis(gen);
+            board[i][j] = randomBit(bits, static_cast<size_t>(i) * m + j);
         }
     }
 
     // Вывод исходной доски
-    cout << "Исходная доска:" << endl;
+    FastOutput& out = fastOutput();
+    out.text("Исходная доска:\n");
     for (const auto& row : board) {
         for (int coin : row) {
-            cout << coin << " ";
+            out.put(static_cast<char>('0' + coin));
+            out.put(' ');
         }
-        cout << endl;
+        out.put('\n');
     }
+    out.flush();
 
-    // Подсчет минимального количества ходов
-    int result = minFlips(board);
-
-    if (result == -1) {
-        cout << "Невозможно преобразовать доску в шахматный узор" << endl;
-    } else {
-        cout << "Минимальное количество ходов: " << result << endl;
-    }
+    // Подсчет минимального количества ходов по упакованной доске
+    PackedBoard packed = packBoard(board);
+    printResult(minFlipsBits(packed));
+    if (exact) printExact(packed);
 
     return 0;
 }
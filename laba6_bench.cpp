@@ -0,0 +1,294 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+
+#include "aes.h"
+#include "aes_multibuffer.h"
+#include "ctr_drbg.h"
+#include "row_scan.h"
+#include "dynamic_row_index.h"
+#include "frequency.h"
+#include "heavy_hitters.h"
+#include "matrix_gen.h"
+#include "coin_flip.h"
+#include "boa_moves.h"
+#include "life.h"
+
+using namespace std;
+
+// Бенчмарк алгоритмов остальных программ (laba6_2, _4, _5, _11, _12, _13);
+// методы СЛАУ измеряет laba6_3_bench.
+// Для каждого алгоритма и размера выводится лучшее время из нескольких
+// повторов, число обработанных элементов в секунду и контрольная сумма
+// результата (по ней видно, что оптимизация не изменила ответ).
+//
+// Запуск: laba6_bench [--sizes 256,1024,...] [--only aes,row_scan,...]
+//                     [--seed S] [--repeat R] [--format csv|json]
+
+// Один бенчмарк: run(n, seed) возвращает контрольную сумму,
+// items(n) - число обрабатываемых элементов. Входные данные run строит при
+// первом вызове для данного n (прогревочный, не замеряется) и кэширует.
+struct Benchmark {
+    string name;
+    function<long long(int, uint64_t)> run;
+    function<double(int)> items;
+};
+
+vector<Benchmark> makeBenchmarks() {
+    vector<Benchmark> benchmarks;
+
+    // Шифрование n * 64 блоков AES-128 в режиме CBC (laba6_2)
+    benchmarks.push_back({"aes", [](int n, uint64_t seed) {
+        vector<Byte> key(16);
+        vector<uint64_t> words(2);
+        randomWords(words.data(), 0, 2, seed);
+        for (int i = 0; i < 16; ++i) key[i] = static_cast<Byte>(words[i / 8] >> (i % 8 * 8));
+        vector<Block> roundKeys = expandKey(key);
+        Block previous{};
+        long long checksum = 0;
+        for (long long i = 0; i < static_cast<long long>(n) * 64; ++i) {
+            Block plain{};
+            plain[0][0] = static_cast<Byte>(i);
+            previous = aesEncryptBlock(xorBlocks(plain, previous), roundKeys);
+            checksum += previous[0][0];
+        }
+        return checksum;
+    }, [](int n) { return static_cast<double>(n) * 64; }});
+
+    // Те же n * 64 блока как n * 8 независимых сообщений по 8 блоков,
+    // пакетное CBC: лучшее ядро и переносимое
+    for (bool portable : {false, true}) {
+        string name = portable ? "aes_cbc_batch_portable" : "aes_cbc_batch";
+        benchmarks.push_back({name, [portable](int n, uint64_t seed) {
+            size_t messages = static_cast<size_t>(n) * 8;
+            vector<uint64_t> words(8);
+            randomWords(words.data(), 0, words.size(), seed);
+            vector<AesKeySchedule> keys;
+            for (int k = 0; k < 4; ++k) {
+                vector<Byte> key(16);
+                for (int i = 0; i < 16; ++i) key[i] = static_cast<Byte>(words[k * 2 + i / 8] >> (i % 8 * 8));
+                keys.push_back(packKeySchedule(expandKey(key)));
+            }
+            vector<Byte> data(messages * 8 * 16);
+            for (size_t i = 0; i < data.size(); i += 16) data[i] = static_cast<Byte>(i / 16);
+            vector<CbcJob> jobs(messages);
+            for (size_t m = 0; m < messages; ++m) {
+                jobs[m].key = &keys[m % keys.size()];
+                jobs[m].iv[0] = static_cast<Byte>(m);
+                jobs[m].input = jobs[m].output = data.data() + m * 8 * 16;
+                jobs[m].blocks = 8;
+            }
+            aesCbcEncryptBatch(jobs, portable ? encryptLanesPortable : selectCbcLaneKernel());
+            long long checksum = 0;
+            for (size_t i = 0; i < data.size(); i += 16) checksum += data[i];
+            return checksum;
+        }, [](int n) { return static_cast<double>(n) * 64; }});
+    }
+
+    // Генерация n * 64 ключей по 16 байт генератором потока (laba6_2);
+    // выход случаен, поэтому контрольная сумма - число ключей
+    benchmarks.push_back({"drbg_keys", [](int n, uint64_t) {
+        Byte key[16];
+        long long keys = 0;
+        for (long long i = 0; i < static_cast<long long>(n) * 64; ++i) {
+            secureRandomBytes(key, sizeof(key));
+            ++keys;
+        }
+        return keys;
+    }, [](int n) { return static_cast<double>(n) * 64; }});
+
+    // Генерация случайной матрицы n x n (laba6_11, laba6_12)
+    benchmarks.push_back({"matrix_gen", [](int n, uint64_t seed) {
+        IntMatrix matrix = randomMatrix(n, n, -100, 100, seed);
+        return static_cast<long long>(matrix.data[matrix.data.size() / 2]);
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // Поиск строки с наибольшим числом положительных (laba6_11)
+    benchmarks.push_back({"row_scan", [](int n, uint64_t seed) {
+        static IntMatrix matrix;
+        if (matrix.rows != n) matrix = randomMatrix(n, n, -100, 100, seed);
+        RowScanResult best = findRowWithMostPositives(matrix);
+        return static_cast<long long>(best.index) * 100000 + best.count;
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // n * 64 изменений клеток матрицы n x n с ответом после каждого (laba6_11 --updates)
+    benchmarks.push_back({"row_index_updates", [](int n, uint64_t seed) {
+        static IntMatrix start;
+        static vector<int> cells, values;
+        size_t count = static_cast<size_t>(n) * 64;
+        if (start.rows != n) {
+            start = randomMatrix(n, n, -100, 100, seed);
+            cells.resize(count);
+            values.resize(count);
+            fillUniformInt(cells.data(), count, 0, n - 1, seed + 1);
+            fillUniformInt(values.data(), count, -100, 100, seed + 2);
+        }
+        DynamicRowIndex index(start); // копия и подсчет строк входят во время
+        long long checksum = 0;
+        for (size_t u = 0; u < count; ++u) {
+            index.set(cells[u], cells[(u + 1) % count], values[u]);
+            checksum += index.best().index;
+        }
+        return checksum;
+    }, [](int n) { return static_cast<double>(n) * 64; }});
+
+    // Точный подсчет частот в диапазоне [100, 150] (laba6_12)
+    benchmarks.push_back({"frequency", [](int n, uint64_t seed) {
+        static IntMatrix matrix;
+        if (matrix.rows != n) matrix = randomMatrix(n, n, 100, 150, seed);
+        ModeResult mode = countFrequencies(matrix.data.data(), matrix.data.size(), 100, 150).mode();
+        return static_cast<long long>(mode.value) * 1000000000LL + mode.count;
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // Приближенные частые значения (laba6_12 --approx)
+    benchmarks.push_back({"heavy_hitters", [](int n, uint64_t seed) {
+        static IntMatrix matrix;
+        if (matrix.rows != n) matrix = randomMatrix(n, n, 100, 150, seed);
+        HeavyHittersSketch sketch = approximateHeavyHitters(matrix.data.data(), matrix.data.size(), 16);
+        return static_cast<long long>(sketch.top()[0].value);
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // Жадное решение для доски n x n: упакованная доска (laba6_5)
+    benchmarks.push_back({"flip_bits", [](int n, uint64_t seed) {
+        static PackedBoard board;
+        if (board.rows != n) {
+            vector<uint64_t> bits((static_cast<size_t>(n) * n + 63) / 64);
+            fillRandomBits(bits.data(), bits.size(), seed);
+            board = packBits(bits.data(), n, n);
+        }
+        return minFlipsBits(board);
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // То же эталонным алгоритмом по доске из int
+    benchmarks.push_back({"flip_reference", [](int n, uint64_t seed) {
+        static vector<vector<int>> board;
+        if (static_cast<int>(board.size()) != n) {
+            vector<uint64_t> bits((static_cast<size_t>(n) * n + 63) / 64);
+            fillRandomBits(bits.data(), bits.size(), seed);
+            board.assign(n, vector<int>(n));
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j) board[i][j] = randomBit(bits, static_cast<size_t>(i) * n + j);
+        }
+        return static_cast<long long>(minFlips(board));
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    // Ходы по n * 64 целевым клеткам с расстояниями до 10^6 (laba6_4)
+    benchmarks.push_back({"boa_moves", [](int n, uint64_t seed) {
+        static vector<long long> cells;
+        size_t count = static_cast<size_t>(n) * 64;
+        if (cells.size() != count) {
+            vector<int> gaps(count);
+            fillUniformInt(gaps.data(), count, 1, 1000000, seed);
+            cells.resize(count);
+            long long cell = 1;
+            for (size_t i = 0; i < count; ++i) cells[i] = cell += gaps[i];
+        }
+        return countMoves(cells.data(), cells.size());
+    }, [](int n) { return static_cast<double>(n) * 64; }});
+
+    // Один шаг "Жизни" на поле n x n (laba6_13)
+    benchmarks.push_back({"life_step", [](int n, uint64_t seed) {
+        static LifeGrid start;
+        if (static_cast<int>(start.size()) != n) {
+            vector<uint64_t> bits((static_cast<size_t>(n) * n + 63) / 64);
+            fillRandomBits(bits.data(), bits.size(), seed);
+            start.assign(n, vector<bool>(n));
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j) start[i][j] = randomBit(bits, static_cast<size_t>(i) * n + j);
+        }
+        LifeGrid grid = start;
+        lifeStep(grid);
+        long long alive = 0;
+        for (const auto& row : grid) alive += count(row.begin(), row.end(), true);
+        return alive;
+    }, [](int n) { return static_cast<double>(n) * n; }});
+
+    return benchmarks;
+}
+
+// =============================================
+//               Основная программа
+// =============================================
+
+// Одна строка результатов в формате CSV или JSON Lines
+void printRecord(const string& format, const string& name, int n, double seconds,
+                 double itemsPerSecond, long long checksum) {
+    if (format == "json") {
+        cout << "{\"benchmark\":\"" << name << "\",\"n\":" << n << ",\"seconds\":" << seconds
+             << ",\"items_per_second\":" << itemsPerSecond << ",\"checksum\":" << checksum << "}\n";
+    } else {
+        cout << name << "," << n << "," << seconds << "," << itemsPerSecond << "," << checksum << "\n";
+    }
+    cout.flush();
+}
+
+vector<string> splitList(const string& s) {
+    vector<string> items;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == string::npos) comma = s.size();
+        if (comma > start) items.push_back(s.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return items;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> sizes = {256, 1024, 4096};
+    vector<string> only;
+    unsigned long long seed = 42;
+    int repeat = 3;
+    string format = "csv";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения\n";
+            return 1;
+        }
+        string value = argv[++i];
+        if (arg == "--sizes") {
+            sizes.clear();
+            for (const string& item : splitList(value)) sizes.push_back(atoi(item.c_str()));
+        } else if (arg == "--only") {
+            only = splitList(value);
+        } else if (arg == "--seed") {
+            seed = strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--repeat") {
+            repeat = max(1, atoi(value.c_str()));
+        } else if (arg == "--format") {
+            format = value;
+        } else {
+            cerr << "Неизвестный параметр: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (format == "csv") {
+        cout << "benchmark,n,seconds,items_per_second,checksum\n";
+    }
+
+    for (const Benchmark& benchmark : makeBenchmarks()) {
+        if (!only.empty() && find(only.begin(), only.end(), benchmark.name) == only.end()) continue;
+        for (int n : sizes) {
+            if (n <= 0) continue;
+            long long checksum = benchmark.run(n, seed); // прогрев и подготовка данных
+            double best = 0;
+            for (int r = 0; r < repeat; ++r) {
+                auto start = chrono::steady_clock::now();
+                checksum = benchmark.run(n, seed);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                if (r == 0 || seconds < best) best = seconds;
+            }
+            double itemsPerSecond = best > 0 ? benchmark.items(n) / best : 0.0;
+            printRecord(format, benchmark.name, n, best, itemsPerSecond, checksum);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,660 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <unordered_map>
+#include <functional>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <atomic>
+
+#include "aes_multibuffer.h"
+#include "linear_solvers.h"
+#include "dominance_reorder.h"
+#include "fixed_size_solvers.h"
+#include "out_of_core_lu.h"
+#include "incremental_solver.h"
+#include "frequency.h"
+#include "heavy_hitters.h"
+#include "row_scan.h"
+#include "matrix_gen.h"
+#include "dynamic_row_index.h"
+#include "life.h"
+#include "life_snapshot.h"
+
+using namespace std;
+
+// Регрессионные проверки общих заголовков (запускаются ctest).
+// Каждая проверка сравнивает быстрый путь с простой эталонной реализацией.
+// Запуск: laba6_tests [ИМЯ ...] - без аргументов выполняются все проверки;
+// код возврата 1, если хотя бы одна не прошла.
+
+int failures = 0;
+
+void expect(bool condition, const string& what) {
+    if (!condition) {
+        cerr << "  не выполнено: " << what << "\n";
+        failures++;
+    }
+}
+
+// =============================================
+//                  AES-CBC
+// =============================================
+
+// Пакет сообщений разной длины (в том числе пустых, сообщений больше, чем
+// дорожек, два ключа вперемешку) против поблочной цепочки aesEncryptBlock
+void testAesCbc() {
+    mt19937 gen(41);
+    vector<vector<Block>> roundKeys(2);
+    vector<AesKeySchedule> schedules(2);
+    for (int k = 0; k < 2; k++) {
+        vector<Byte> key(16);
+        for (Byte& b : key) b = static_cast<Byte>(gen());
+        roundKeys[k] = expandKey(key);
+        schedules[k] = packKeySchedule(roundKeys[k]);
+        AesKeySchedule direct;
+        expandKeySchedule(key.data(), direct);
+        expect(memcmp(&direct, &schedules[k], sizeof(direct)) == 0,
+               "expandKeySchedule совпадает с packKeySchedule(expandKey)");
+    }
+
+    const size_t jobCount = 3 * AES_LANES + 5;
+    vector<vector<Byte>> plain(jobCount);
+    vector<CbcJob> jobs(jobCount);
+    for (size_t m = 0; m < jobCount; m++) {
+        size_t blocks = m % 5 == 0 ? 0 : gen() % 40 + 1;
+        plain[m].resize(blocks * 16);
+        for (Byte& b : plain[m]) b = static_cast<Byte>(gen());
+        jobs[m].key = &schedules[m % 2];
+        for (Byte& b : jobs[m].iv) b = static_cast<Byte>(gen());
+        jobs[m].blocks = blocks;
+    }
+
+    // Эталон: CBC блок за блоком
+    vector<vector<Byte>> expected(jobCount);
+    for (size_t m = 0; m < jobCount; m++) {
+        expected[m].resize(plain[m].size());
+        Byte chain[16];
+        memcpy(chain, jobs[m].iv, 16);
+        for (size_t blk = 0; blk < jobs[m].blocks; blk++) {
+            Byte x[16];
+            for (int j = 0; j < 16; j++) x[j] = plain[m][blk * 16 + j] ^ chain[j];
+            blockToBytes(aesEncryptBlock(bytesToBlock(x), roundKeys[m % 2]), chain);
+            memcpy(&expected[m][blk * 16], chain, 16);
+        }
+    }
+
+    const pair<string, CbcLaneKernel> kernels[] = {
+        {"выбранное ядро", selectCbcLaneKernel()},
+        {"переносимое ядро", encryptLanesPortable},
+    };
+    for (const auto& [name, kernel] : kernels) {
+        // Нечетные сообщения шифруются на месте
+        vector<vector<Byte>> out(jobCount);
+        for (size_t m = 0; m < jobCount; m++) {
+            out[m] = m % 2 ? plain[m] : vector<Byte>(plain[m].size());
+            jobs[m].input = m % 2 ? out[m].data() : plain[m].data();
+            jobs[m].output = out[m].data();
+        }
+        aesCbcEncryptBatch(jobs, kernel);
+        expect(out == expected, "aesCbcEncryptBatch совпадает с цепочкой aesEncryptBlock (" + name + ")");
+    }
+}
+
+// =============================================
+//                  СЛАУ
+// =============================================
+
+vector<vector<double>> dominantMatrix(int n, mt19937_64& gen, bool symmetric) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    vector<vector<double>> A(n, vector<double>(n));
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < (symmetric ? i : n); j++) {
+            A[i][j] = dis(gen);
+            if (symmetric) A[j][i] = A[i][j];
+        }
+    for (int i = 0; i < n; i++) {
+        double rowSum = 0;
+        for (int j = 0; j < n; j++)
+            if (j != i) rowSum += fabs(A[i][j]);
+        A[i][i] = rowSum + 1.0;
+    }
+    return A;
+}
+
+double residualOf(const vector<vector<double>>& A, const vector<double>& b, const vector<double>& x) {
+    return maxResidual(calculateResidual(A, b, x));
+}
+
+void testLinearSolvers() {
+    mt19937_64 gen(1);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (int n : {1, 4, 17, 64}) {
+        for (bool symmetric : {false, true}) {
+            vector<vector<double>> A = dominantMatrix(n, gen, symmetric);
+            vector<double> b(n);
+            for (double& v : b) v = dis(gen);
+            string tag = " (n = " + to_string(n) + (symmetric ? ", симметричная)" : ")");
+
+            vector<vector<double>> L, U;
+            LUDecomposition(A, L, U);
+            expect(residualOf(A, b, BackwardSubstitution(U, ForwardSubstitution(L, b))) < 1e-10,
+                   "невязка LU" + tag);
+
+            vector<double> x(n, 0.0);
+            bool converged = false;
+            SeidelIterations(A, b, x, EPSILON, 1000, &converged);
+            expect(converged && residualOf(A, b, x) < 1e-4, "сходимость и невязка Зейделя" + tag);
+
+            vector<double> mixed;
+            MixedPrecisionLU(A, b, mixed);
+            expect(residualOf(A, b, mixed) < 1e-5, "невязка LU смешанной точности" + tag);
+
+            string method;
+            vector<double> automatic = SolveAuto(A, b, &method);
+            expect(residualOf(A, b, automatic) < 1e-4, "невязка SolveAuto, метод " + method + tag);
+
+            // Перемешанные строки: перестановка должна вернуть преобладание
+            vector<vector<double>> P = A;
+            vector<double> c = b;
+            for (int i = 0; i + 1 < n; i += 2) {
+                swap(P[i], P[i + 1]);
+                swap(c[i], c[i + 1]);
+            }
+            vector<double> reordered = SolveReordered(P, c, &method);
+            expect(residualOf(P, c, reordered) < 1e-4, "невязка SolveReordered, метод " + method + tag);
+        }
+    }
+
+    // Трехдиагональная и ленточная системы идут через специальные методы
+    int n = 40;
+    vector<vector<double>> T(n, vector<double>(n, 0.0));
+    vector<double> b(n, 1.0);
+    for (int i = 0; i < n; i++) {
+        T[i][i] = 4.0;
+        if (i > 0) T[i][i - 1] = -1.0;
+        if (i + 1 < n) T[i][i + 1] = -1.5;
+    }
+    string method;
+    vector<double> x = SolveAuto(T, b, &method);
+    expect(method == "thomas" && residualOf(T, b, x) < 1e-10, "прогонка для трехдиагональной, метод " + method);
+    for (int i = 0; i + 3 < n; i++) T[i][i + 3] = 0.5;
+    x = SolveAuto(T, b, &method);
+    expect(method == "banded_lu" && residualOf(T, b, x) < 1e-10, "ленточное LU, метод " + method);
+
+    // Пустая система: ни один метод не обращается к элементам
+    x = SolveAuto({}, {}, &method);
+    expect(x.empty(), "пустая система, метод " + method);
+}
+
+// Холецкий: невязка при разном числе потоков и размере блока (блоки не
+// кратны n), отказ на не положительно определенной матрице
+void testCholesky() {
+    mt19937_64 gen(29);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (int n : {1, 5, 70, 150}) {
+        vector<vector<double>> A = dominantMatrix(n, gen, true);
+        vector<double> b(n);
+        for (double& v : b) v = dis(gen);
+        for (int threads : {1, 4}) {
+            for (int block : {1, 16, 64}) {
+                PackedLower L;
+                bool ok = CholeskyDecomposition(A, L, threads, block);
+                expect(ok && residualOf(A, b, CholeskySolve(L, b)) < 1e-10,
+                       "невязка Холецкого (n = " + to_string(n) + ", потоков " + to_string(threads)
+                       + ", блок " + to_string(block) + ")");
+            }
+        }
+    }
+    vector<vector<double>> indefinite = {{1.0, 2.0}, {2.0, 1.0}};
+    PackedLower L;
+    expect(!CholeskyDecomposition(indefinite, L), "Холецкий отвергает незнакоопределенную матрицу");
+}
+
+// Плиточное LU во внешней памяти против LU в памяти: n не кратно плитке,
+// пул минимальный (плитки постоянно вытесняются) и с запасом; нулевой
+// ведущий элемент отвергается
+void testOutOfCore() {
+    mt19937_64 gen(43);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (int n : {1, 37, 100}) {
+        vector<vector<double>> A = dominantMatrix(n, gen, false);
+        vector<double> b(n);
+        for (double& v : b) v = dis(gen);
+        vector<vector<double>> L, U;
+        LUDecomposition(A, L, U);
+        vector<double> reference = BackwardSubstitution(U, ForwardSubstitution(L, b));
+
+        for (int tile : {8, 16, 64}) {
+            int tiles = (n + tile - 1) / tile;
+            for (size_t poolTiles : {size_t(4), size_t(tiles * tiles + 4)}) {
+                for (int threads : {1, 3}) {
+                    OutOfCoreMatrix M("laba6_tests.tiles", n, tile, poolTiles, threads);
+                    M.fill(A);
+                    bool ok = M.ok() && M.factorize();
+                    vector<double> x = ok ? M.solve(b) : vector<double>();
+                    bool same = ok;
+                    for (int i = 0; same && i < n; i++) same = fabs(x[i] - reference[i]) < 1e-10;
+                    expect(same, "OutOfCoreMatrix совпадает с LU (n = " + to_string(n) + ", плитка "
+                           + to_string(tile) + ", пул " + to_string(poolTiles) + ", потоков "
+                           + to_string(threads) + ")");
+                }
+            }
+        }
+    }
+    vector<vector<double>> singular = {{0.0, 1.0}, {1.0, 0.0}};
+    OutOfCoreMatrix M("laba6_tests.tiles", 2, 1, 4, 1);
+    M.fill(singular);
+    expect(!M.factorize(), "OutOfCoreMatrix отвергает нулевой ведущий элемент");
+}
+
+// Повторные решения после изменений коэффициентов и обновлений ранга 1
+// против LU текущей матрицы с нуля; изменений больше порога, поэтому
+// проверяется и поправка Вудбери, и новое разложение
+void testIncremental() {
+    mt19937_64 gen(45);
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    const int n = 40;
+    for (int maxRank : {0, 3}) {
+        vector<vector<double>> M = dominantMatrix(n, gen, false);
+        vector<double> b(n);
+        for (double& v : b) v = dis(gen);
+        IncrementalSolver woodbury(M, maxRank), warm(M, maxRank);
+
+        bool same = true, matrixSame = true, seidelSame = true;
+        for (int u = 0; u < 30; u++) {
+            if (u % 4 == 3) {
+                // Малое обновление ранга 1 сохраняет преобладание
+                vector<double> p(n), q(n);
+                for (int i = 0; i < n; i++) {
+                    p[i] = dis(gen) * 0.01;
+                    q[i] = dis(gen) * 0.01;
+                }
+                for (int i = 0; i < n; i++)
+                    for (int j = 0; j < n; j++) M[i][j] += p[i] * q[j];
+                woodbury.addRank1(p, q);
+                warm.addRank1(p, q);
+            } else {
+                int i = gen() % n, j = (i + 1 + gen() % (n - 1)) % n;
+                double value = dis(gen) * 0.5;
+                M[i][j] = value;
+                woodbury.setCoefficient(i, j, value);
+                warm.setCoefficient(i, j, value);
+            }
+
+            vector<vector<double>> L, U;
+            LUDecomposition(M, L, U);
+            vector<double> reference = BackwardSubstitution(U, ForwardSubstitution(L, b));
+            const vector<double>& x = woodbury.solve(b);
+            for (int i = 0; i < n; i++) same = same && fabs(x[i] - reference[i]) < 1e-10;
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    matrixSame = matrixSame && fabs(woodbury.matrix()[i][j] - M[i][j]) < 1e-15;
+            seidelSame = seidelSame && residualOf(M, b, warm.solveSeidel(b)) < 1e-4;
+        }
+        string tag = " (maxRank = " + to_string(maxRank) + ")";
+        expect(matrixSame, "IncrementalSolver::matrix() совпадает с измененной матрицей" + tag);
+        expect(same, "решение Вудбери совпадает с LU с нуля" + tag);
+        expect(woodbury.statistics().refactorizations > 1, "после порога матрица раскладывается заново" + tag);
+        expect(seidelSame, "невязка Зейделя с теплым стартом" + tag);
+    }
+}
+
+// SolveFixed против общего LU и SolveBatch против SolveFixed; в пакете
+// неполная последняя группа и вырожденная система (ответ - NaN)
+template <int N>
+void checkFixedSize(mt19937_64& gen) {
+    uniform_real_distribution<double> dis(-1.0, 1.0);
+    const size_t count = 2 * BATCH_LANES + 3;
+    vector<Matrix<N>> A(count);
+    vector<Vector<N>> b(count), x(count);
+    for (size_t s = 0; s < count; s++) {
+        for (int i = 0; i < N; i++) {
+            double rowSum = 0;
+            for (int j = 0; j < N; j++) {
+                A[s][i][j] = dis(gen);
+                if (j != i) rowSum += fabs(A[s][i][j]);
+            }
+            A[s][i][i] = rowSum + 1.0;
+            b[s][i] = dis(gen);
+        }
+    }
+    for (int j = 0; j < N; j++) A[5][0][j] = 0.0; // нулевая строка - нулевой ведущий элемент
+
+    size_t singular = SolveBatch(A.data(), b.data(), x.data(), count);
+    expect(singular == 1 && isnan(x[5][0]), "SolveBatch помечает вырожденную систему, N = " + to_string(N));
+
+    bool same = true;
+    for (size_t s = 0; s < count; s++) {
+        if (s == 5) continue;
+        Vector<N> single;
+        vector<vector<double>> dense(N, vector<double>(N));
+        vector<double> rhs(N);
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) dense[i][j] = A[s][i][j];
+            rhs[i] = b[s][i];
+        }
+        vector<vector<double>> L, U;
+        LUDecomposition(dense, L, U);
+        vector<double> reference = BackwardSubstitution(U, ForwardSubstitution(L, rhs));
+        same = same && SolveFixed(A[s], b[s], single);
+        for (int i = 0; i < N; i++)
+            same = same && fabs(single[i] - reference[i]) < 1e-12 && fabs(x[s][i] - single[i]) < 1e-12;
+    }
+    expect(same, "SolveFixed и SolveBatch совпадают с LU, N = " + to_string(N));
+}
+
+void testFixedSize() {
+    mt19937_64 gen(30);
+    checkFixedSize<2>(gen);
+    checkFixedSize<3>(gen);
+    checkFixedSize<4>(gen);
+    checkFixedSize<5>(gen);
+    checkFixedSize<8>(gen);
+}
+
+// =============================================
+//           Частоты и частые значения
+// =============================================
+
+void testFrequency() {
+    mt19937 gen(5);
+    for (int trial = 0; trial < 60; trial++) {
+        size_t n = gen() % 5000 + 1;
+        int lo = -static_cast<int>(gen() % 300), hi = lo + static_cast<int>(gen() % 400);
+        // Часть значений выходит за [lo, hi] и попадает в хеш-таблицу
+        vector<int> values(n);
+        for (int& v : values) v = lo - 20 + static_cast<int>(gen() % (hi - lo + 41));
+
+        unordered_map<int, long long> reference;
+        for (int v : values) reference[v]++;
+
+        FrequencyCounter dense(lo, hi), sparse;
+        dense.add(values.data(), n);
+        sparse.add(values.data(), n);
+        for (const FrequencyCounter* counter : {&dense, &sparse}) {
+            size_t distinct = 0;
+            bool same = true;
+            counter->forEach([&](int value, long long count) {
+                distinct++;
+                auto it = reference.find(value);
+                if (it == reference.end() || it->second != count) same = false;
+            });
+            expect(same && distinct == reference.size(),
+                   string("частоты ") + (counter == &dense ? "плоского массива" : "хеш-таблицы")
+                   + " совпадают с unordered_map");
+        }
+
+        ModeResult expected;
+        for (const auto& [value, count] : reference)
+            if (count > expected.count || (count == expected.count && value < expected.value))
+                expected = {value, count};
+        ModeResult parallel = countFrequencies(values.data(), n, 4).mode();
+        expect(parallel.value == expected.value && parallel.count == expected.count,
+               "мода параллельного подсчета");
+    }
+}
+
+// Эскизы: истинная частота лежит в [lowerBound, estimate], самые частые
+// значения находятся, параллельный подсчет со слиянием не нарушает границ
+void testHeavyHitters() {
+    mt19937 gen(34);
+    // Смесь: 10 частых значений и длинный хвост редких
+    vector<int> values(400000);
+    for (int& v : values) v = gen() % 4 == 0 ? static_cast<int>(gen() % 10) : static_cast<int>(gen() % 1000000) + 100;
+    unordered_map<int, long long> reference;
+    for (int v : values) reference[v]++;
+
+    for (int threads : {1, 4}) {
+        HeavyHittersSketch sketch = approximateHeavyHitters(values.data(), values.size(), 64, threads);
+        vector<ApproxFrequency> top = sketch.top();
+        string tag = " (потоков " + to_string(threads) + ")";
+        expect(sketch.count() == static_cast<long long>(values.size()), "число элементов эскиза" + tag);
+
+        bool bounded = true;
+        int frequentFound = 0;
+        for (const ApproxFrequency& f : top) {
+            long long truth = reference[f.value];
+            bounded = bounded && f.lowerBound <= truth && truth <= f.estimate
+                      && f.estimate - truth <= sketch.spaceSavingErrorBound();
+            if (f.value >= 0 && f.value < 10) frequentFound++;
+        }
+        expect(bounded, "истинная частота в границах оценки" + tag);
+        expect(frequentFound == 10, "все 10 частых значений найдены" + tag);
+        // Частые значения встречаются ~10000 раз > n / k, поэтому Space-Saving обязан их
+        // удержать; хвост - единицы, так что первые 10 мест - частые
+        bool leading = top.size() >= 10;
+        for (size_t i = 0; leading && i < 10; i++) leading = top[i].value < 10;
+        expect(leading, "частые значения идут первыми" + tag);
+    }
+}
+
+// =============================================
+//            Генератор Philox и строки матрицы
+// =============================================
+
+// Известные ответы Philox4x32-10 (тестовые векторы Random123)
+void testPhilox() {
+    struct KnownAnswer {
+        uint32_t counter[4];
+        uint64_t key;
+        uint32_t output[4];
+    };
+    const KnownAnswer answers[] = {
+        {{0, 0, 0, 0}, 0, {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}},
+        {{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, 0xffffffffffffffffull,
+         {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}},
+        {{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, 0x299f31d0a4093822ull,
+         {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}},
+    };
+    for (const KnownAnswer& a : answers) {
+        PhiloxLanes x;
+        for (int l = 0; l < PHILOX_LANES; ++l) {
+            x.c0[l] = a.counter[0];
+            x.c1[l] = a.counter[1];
+            x.c2[l] = a.counter[2];
+            x.c3[l] = a.counter[3];
+        }
+        philox4x32Lanes(x, a.key);
+        bool same = true;
+        for (int l = 0; l < PHILOX_LANES; ++l)
+            same = same && x.c0[l] == a.output[0] && x.c1[l] == a.output[1]
+                   && x.c2[l] == a.output[2] && x.c3[l] == a.output[3];
+        expect(same, "известный ответ Philox4x32-10");
+    }
+
+    // Слова 0 и 1 при seed 0 - выход для нулевого счетчика
+    uint64_t words[2];
+    randomWords(words, 0, 2, 0);
+    expect(words[0] == 0xe169c58d6627e8d5ull && words[1] == 0x9b00dbd8bc57ac4cull,
+           "randomWords для нулевого счетчика");
+
+    // Результат не зависит от числа потоков, значения в диапазоне
+    vector<int> one(100003), many(100003);
+    fillUniformInt(one.data(), one.size(), -7, 9, 35, 1);
+    fillUniformInt(many.data(), many.size(), -7, 9, 35, 5);
+    bool inRange = true;
+    for (int v : one) inRange = inRange && v >= -7 && v <= 9;
+    expect(one == many, "fillUniformInt не зависит от числа потоков");
+    expect(inRange, "fillUniformInt в заданном диапазоне");
+}
+
+RowScanResult scalarScan(const IntMatrix& matrix) {
+    RowScanResult best;
+    for (int i = 0; i < matrix.rows; i++) {
+        int count = countPositiveScalar(matrix[i], matrix.cols);
+        if (count > best.count) best = {i, count};
+    }
+    return best;
+}
+
+void testRowScan() {
+    for (int rows : {1, 3, 17, 200}) {
+        for (int cols : {1, 7, 8, 33, 100}) {
+            IntMatrix matrix = randomMatrix(rows, cols, -100, 100, rows * 1000 + cols);
+            RowScanResult expected = scalarScan(matrix);
+            string tag = " (" + to_string(rows) + "x" + to_string(cols) + ")";
+
+            CountPositiveFn fast = selectCountPositive();
+            bool same = true;
+            for (int i = 0; i < rows; i++)
+                same = same && fast(matrix[i], cols) == countPositiveScalar(matrix[i], cols);
+            expect(same, "векторный подсчет совпадает со скалярным" + tag);
+
+            for (int threads : {1, 4}) {
+                RowScanResult r = findRowWithMostPositives(matrix, threads);
+                expect(r.index == expected.index && r.count == expected.count,
+                       "findRowWithMostPositives, потоков " + to_string(threads) + tag);
+            }
+
+            // Поток изменений: индекс совпадает с полным просмотром
+            DynamicRowIndex index(matrix);
+            mt19937 gen(rows + cols);
+            for (int u = 0; u < 200; u++) {
+                index.set(gen() % rows, gen() % cols, static_cast<int>(gen() % 201) - 100);
+            }
+            RowScanResult after = scalarScan(index.matrix());
+            expect(index.best().index == after.index && index.best().count == after.count,
+                   "DynamicRowIndex после изменений" + tag);
+        }
+    }
+}
+
+// =============================================
+//                  "Жизнь"
+// =============================================
+
+// Эталонный шаг: новое поле строится заново, соседи - явным перебором
+LifeGrid referenceStep(const LifeGrid& grid) {
+    int rows = grid.size(), cols = grid[0].size();
+    LifeGrid next(rows, vector<bool>(cols, false));
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++) {
+            int n = 0;
+            for (int di = -1; di <= 1; di++)
+                for (int dj = -1; dj <= 1; dj++)
+                    if (di || dj) n += grid[(i + di + rows) % rows][(j + dj + cols) % cols];
+            next[i][j] = n == 3 || (grid[i][j] && n == 2);
+        }
+    return next;
+}
+
+void testLife() {
+    mt19937 gen(13);
+    for (int size : {3, 8, 21}) {
+        LifeGrid grid(size, vector<bool>(size));
+        for (auto& row : grid)
+            for (size_t j = 0; j < row.size(); j++) row[j] = gen() % 3 == 0;
+
+        // dst с мусором: lifeStepInto должен перезаписать каждую клетку
+        LifeGrid into(size, vector<bool>(size, true));
+        LifeSnapshotSlot slot(grid);
+        bool same = true;
+        for (int generation = 1; generation <= 10; generation++) {
+            LifeGrid expected = referenceStep(grid);
+            lifeStepInto(grid, into);
+            lifeStep(grid);
+            slot.step();
+            LifeSnapshotSlot::View view = slot.acquire();
+            same = same && grid == expected && into == expected
+                   && view && view.grid() == expected && view.generation() == generation;
+        }
+        expect(same, "lifeStep, lifeStepInto и LifeSnapshotSlot совпадают с эталоном (поле "
+               + to_string(size) + ")");
+    }
+}
+
+// Писатель публикует поколения, пока maxReaders читателей закрепляют кадры:
+// каждый закрепленный кадр - целое поколение (эталонный шаг от предыдущего),
+// номера поколений у читателя не убывают, лишнее закрепление не выдается
+void testLifeSnapshot() {
+    const int SIZE = 24, GENERATIONS = 300;
+    mt19937 gen(47);
+    vector<LifeGrid> history(1, LifeGrid(SIZE, vector<bool>(SIZE)));
+    for (auto& row : history[0])
+        for (int j = 0; j < SIZE; j++) row[j] = gen() % 3 == 0;
+    for (int g = 1; g <= GENERATIONS; g++) history.push_back(referenceStep(history[g - 1]));
+
+    for (int readers : {2, 3}) {
+        LifeSnapshotSlot slot(history[0], readers);
+        atomic<bool> done{false};
+        vector<int> torn(readers, 0), backwards(readers, 0), refused(readers, 0);
+
+        vector<thread> pool;
+        for (int r = 0; r < readers; r++) {
+            pool.emplace_back([&, r]() {
+                long long last = 0;
+                while (!done.load()) {
+                    LifeSnapshotSlot::View view = slot.acquire();
+                    if (!view) {
+                        refused[r]++;
+                        continue;
+                    }
+                    long long g = view.generation();
+                    if (g < last) backwards[r]++;
+                    if (g < 0 || g > GENERATIONS || view.grid() != history[g]) torn[r]++;
+                    last = g;
+                }
+            });
+        }
+        for (int g = 1; g <= GENERATIONS; g++) {
+            slot.step();
+            if (g % 16 == 0) this_thread::yield(); // дать читателям закрепить кадр
+        }
+        done.store(true);
+        for (thread& th : pool) th.join();
+
+        string tag = " (читателей " + to_string(readers) + ")";
+        bool ok = true, cleanOrder = true, allowed = true;
+        for (int r = 0; r < readers; r++) {
+            ok = ok && torn[r] == 0;
+            cleanOrder = cleanOrder && backwards[r] == 0;
+            allowed = allowed && refused[r] == 0;
+        }
+        expect(ok, "каждый закрепленный кадр совпадает с эталонным поколением" + tag);
+        expect(cleanOrder, "поколения у читателя не убывают" + tag);
+        expect(allowed, "maxReaders читателей получают кадры" + tag);
+        expect(slot.generation() == GENERATIONS, "опубликовано последнее поколение" + tag);
+
+        // Все закрепления заняты: следующее acquire возвращает пустой View
+        vector<LifeSnapshotSlot::View> held;
+        for (int r = 0; r < readers; r++) held.push_back(slot.acquire());
+        expect(!slot.acquire(), "закрепление сверх maxReaders не выдается" + tag);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<pair<string, function<void()>>> tests = {
+        {"aes_cbc", testAesCbc},
+        {"linear_solvers", testLinearSolvers},
+        {"cholesky", testCholesky},
+        {"fixed_size", testFixedSize},
+        {"out_of_core", testOutOfCore},
+        {"incremental", testIncremental},
+        {"frequency", testFrequency},
+        {"heavy_hitters", testHeavyHitters},
+        {"philox", testPhilox},
+        {"row_scan", testRowScan},
+        {"life", testLife},
+        {"life_snapshot", testLifeSnapshot},
+    };
+
+    int run = 0;
+    for (const auto& [name, test] : tests) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++) selected = selected || name == argv[i];
+        if (!selected) continue;
+        int before = failures;
+        test();
+        cout << name << ": " << (failures == before ? "ok" : "ОШИБКА") << "\n";
+        run++;
+    }
+    if (run == 0) {
+        cerr << "Нет проверок с такими именами\n";
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
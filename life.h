@@ -0,0 +1,46 @@
+#ifndef LIFE_H
+#define LIFE_H
+
+// Игра "Жизнь" (laba6_13.cpp): поле с тороидальной топологией
+// (края соединены) и один шаг по правилам B3/S23.
+
+#include <vector>
+
+#include "profiler.h"
+
+using namespace std;
+
+// Игровое поле
+using LifeGrid = vector<vector<bool>>;
+
+// Считаем соседей клетки (x, y)
+inline int countNeighbors(const LifeGrid& grid, int x, int y) {
+    int rows = grid.size(), cols = grid[0].size();
+    int count = 0;
+    for (int i = -1; i <= 1; i++)
+        for (int j = -1; j <= 1; j++)
+            if (i || j) // не считаем саму клетку
+                count += grid[(x+i+rows)%rows][(y+j+cols)%cols];
+    return count;
+}
+
+// Следующее поколение src в dst (dst заранее того же размера)
+inline void lifeStepInto(const LifeGrid& src, LifeGrid& dst) {
+    PROFILE_SCOPE("lifeStep");
+    int rows = src.size(), cols = rows > 0 ? src[0].size() : 0;
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++) {
+            int n = countNeighbors(src, i, j);
+            if (src[i][j]) dst[i][j] = (n == 2 || n == 3);
+            else dst[i][j] = (n == 3);
+        }
+}
+
+// Обновляем состояние
+inline void lifeStep(LifeGrid& grid) {
+    auto newGrid = grid;
+    lifeStepInto(grid, newGrid);
+    grid = newGrid;
+}
+
+#endif // LIFE_H
@@ -0,0 +1,139 @@
+#ifndef LIFE_SNAPSHOT_H
+#define LIFE_SNAPSHOT_H
+
+// Публикация поколений "Жизни" для читателей в других потоках (laba6_13.cpp).
+// Поток моделирования считает поколение прямо в свободный кадр (из
+// опубликованного) и публикует его одной атомарной записью номера кадра.
+// Читатели (вывод на экран, статистика, сохранение) закрепляют текущий кадр
+// счетчиком читателей и читают его без блокировок и без копирования поля.
+//
+// Закрепление: прочитать номер текущего кадра, увеличить счетчик читателей
+// кадра и проверить, что кадр все еще текущий; если нет - отпустить и
+// повторить. Писатель берет только кадр, который не текущий и у которого
+// счетчик равен 0. Все операции seq_cst, поэтому писатель либо видит
+// закрепление, либо читатель видит новую публикацию и уходит на повтор.
+// Кадров maxReaders + 2, и больше maxReaders закреплений одновременно
+// acquire не выдает (возвращает пустой View): даже если каждый читатель
+// держит свой кадр, писателю остается хотя бы один свободный. Ждать ему
+// приходится, только пока читатель отпускает кадр, закрепленный во время
+// смены текущего.
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+#include "life.h"
+
+using namespace std;
+
+// Кадр: поле, номер поколения и счетчик закрепивших его читателей
+struct alignas(64) LifeSnapshot {
+    LifeGrid grid;
+    long long generation = 0;
+    atomic<int> readers{0};
+};
+
+class LifeSnapshotSlot {
+public:
+    // maxReaders - сколько читателей могут одновременно держать кадры
+    explicit LifeSnapshotSlot(const LifeGrid& initial, int maxReaders = 1)
+        : maxReaders(max(1, maxReaders)) {
+        int count = this->maxReaders + 2;
+        for (int i = 0; i < count; i++) {
+            frames.push_back(make_unique<LifeSnapshot>());
+            frames.back()->grid = initial;
+        }
+    }
+
+    // Закрепленный кадр; отпускается в деструкторе. Пустой View - читателей
+    // уже maxReaders
+    class View {
+    public:
+        View() = default;
+        View(LifeSnapshot* frame, atomic<int>* views) : frame(frame), views(views) {}
+        View(View&& other) noexcept : frame(other.frame), views(other.views) {
+            other.frame = nullptr;
+        }
+        View& operator=(View&& other) noexcept {
+            if (this != &other) {
+                release();
+                frame = other.frame;
+                views = other.views;
+                other.frame = nullptr;
+            }
+            return *this;
+        }
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        ~View() { release(); }
+
+        explicit operator bool() const { return frame != nullptr; }
+        const LifeGrid& grid() const { return frame->grid; }
+        long long generation() const { return frame->generation; }
+
+    private:
+        LifeSnapshot* frame = nullptr;
+        atomic<int>* views = nullptr;
+
+        void release() {
+            if (frame) {
+                frame->readers.fetch_sub(1);
+                views->fetch_sub(1);
+            }
+            frame = nullptr;
+        }
+    };
+
+    // Последнее опубликованное поколение (для читателей)
+    View acquire() const {
+        if (views.fetch_add(1) >= maxReaders) {
+            views.fetch_sub(1);
+            return View();
+        }
+        while (true) {
+            int index = current.load();
+            LifeSnapshot* frame = frames[index].get();
+            frame->readers.fetch_add(1);
+            if (current.load() == index) return View(frame, &views);
+            frame->readers.fetch_sub(1); // кадр успели сменить
+        }
+    }
+
+    // Номер опубликованного поколения (из любого потока, без закрепления)
+    long long generation() const { return published.load(); }
+
+    // Следующее поколение (только поток моделирования); возвращает его номер
+    long long step() {
+        int from = current.load();
+        int to = freeFrame(from);
+        const LifeSnapshot& src = *frames[from];
+        LifeSnapshot& dst = *frames[to];
+        lifeStepInto(src.grid, dst.grid);
+        dst.generation = src.generation + 1;
+        current.store(to);
+        published.store(dst.generation);
+        return dst.generation;
+    }
+
+private:
+    vector<unique_ptr<LifeSnapshot>> frames;
+    atomic<int> current{0};
+    atomic<long long> published{0}; // поколение кадра current
+    int maxReaders;
+    mutable atomic<int> views{0};   // выданных acquire закреплений
+
+    // Кадр без читателей, кроме текущего; закреплений не больше maxReaders,
+    // поэтому такой есть всегда (повтор - только из-за временных закреплений)
+    int freeFrame(int busy) const {
+        int count = frames.size();
+        while (true) {
+            for (int i = 1; i < count; i++) {
+                int index = (busy + i) % count;
+                if (frames[index]->readers.load() == 0) return index;
+            }
+        }
+    }
+};
+
+#endif // LIFE_SNAPSHOT_H
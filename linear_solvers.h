@@ -0,0 +1,663 @@
+#ifndef LINEAR_SOLVERS_H
+#define LINEAR_SOLVERS_H
+
+// Методы решения систем линейных алгебраических уравнений (общие для
+// laba6_3.cpp и бенчмарка laba6_3_bench.cpp)
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "profiler.h"
+
+using namespace std;
+
+const double EPSILON = 1e-6;
+
+// LU-разложение матрицы (T - double или float для смешанной точности)
+template <typename T>
+void LUDecomposition(const vector<vector<T>>& A,
+                     vector<vector<T>>& L,
+                     vector<vector<T>>& U) {
+    PROFILE_SCOPE("LUDecomposition");
+    int n = A.size();
+    L = vector<vector<T>>(n, vector<T>(n, 0));
+    U = vector<vector<T>>(n, vector<T>(n, 0));
+
+    for (int i = 0; i < n; i++) {
+        // Верхняя треугольная матрица U
+        for (int k = i; k < n; k++) {
+            T sum = 0;
+            for (int j = 0; j < i; j++) {
+                sum += L[i][j] * U[j][k];
+            }
+            U[i][k] = A[i][k] - sum;
+        }
+
+        // Нижняя треугольная матрица L
+        for (int k = i; k < n; k++) {
+            if (i == k) {
+                L[i][i] = 1;
+            } else {
+                T sum = 0;
+                for (int j = 0; j < i; j++){
+                    sum += L[k][j] * U[j][i];
+                }
+                L[k][i] = (A[k][i] - sum) / U[i][i];
+            }
+        }
+    }
+}
+
+// Прямая подстановка Ly = b
+template <typename T>
+vector<T> ForwardSubstitution(const vector<vector<T>>& L,
+                              const vector<T>& b) {
+    PROFILE_SCOPE("ForwardSubstitution");
+    int n = L.size();
+    vector<T> y(n, 0);
+
+    for (int i = 0; i < n; i++) {
+        T sum = 0;
+        for (int j = 0; j < i; j++) {
+            sum += L[i][j] * y[j];
+        }
+        y[i] = (b[i] - sum) / L[i][i];
+    }
+
+    return y;
+}
+
+// Обратная подстановка Ux = y
+template <typename T>
+vector<T> BackwardSubstitution(const vector<vector<T>>& U,
+                               const vector<T>& y) {
+    PROFILE_SCOPE("BackwardSubstitution");
+    int n = U.size();
+    vector<T> x(n, 0);
+
+    for (int i = n - 1; i >= 0; i--) {
+        T sum = 0;
+        for (int j = i + 1; j < n; j++) {
+            sum += U[i][j] * x[j];
+        }
+        x[i] = (y[i] - sum) / U[i][i];
+    }
+
+    return x;
+}
+
+// Вычисление невязки
+inline vector<double> calculateResidual(const vector<vector<double>>& A,
+                                       const vector<double>& b,
+                                       const vector<double>& x) {
+    int n = A.size();
+    vector<double> residual(n, 0);
+
+    for (int i = 0; i < n; i++) {
+        double sum = 0;
+        for (int j = 0; j < n; j++) {
+            sum += A[i][j] * x[j];
+        }
+        residual[i] = b[i] - sum;
+    }
+
+    return residual;
+}
+
+// LU-разложение на месте в непрерывном буфере n x n по строкам (без выбора
+// ведущего элемента, как LUDecomposition): ниже диагонали - L с единичной
+// диагональю, на диагонали и выше - U. Строка обновляется одним проходом
+// по непрерывной памяти, поэтому внутренний цикл векторизуется.
+// Возвращает false при нулевом или переполненном ведущем элементе.
+template <typename T>
+bool DenseLUDecomposition(vector<T>& a, int n) {
+    PROFILE_SCOPE("DenseLUDecomposition");
+    for (int k = 0; k < n; k++) {
+        const T* pivotRow = a.data() + static_cast<size_t>(k) * n;
+        T pivot = pivotRow[k];
+        if (pivot == 0 || !isfinite(pivot)) {
+            return false;
+        }
+        for (int i = k + 1; i < n; i++) {
+            T* row = a.data() + static_cast<size_t>(i) * n;
+            T l = row[k] / pivot;
+            row[k] = l;
+#pragma omp simd
+            for (int j = k + 1; j < n; j++) {
+                row[j] -= l * pivotRow[j];
+            }
+        }
+    }
+    return true;
+}
+
+// Решение LUx = b по разложению DenseLUDecomposition; x на входе - b
+template <typename T>
+void DenseLUSolve(const vector<T>& a, int n, vector<T>& x) {
+    for (int i = 1; i < n; i++) {
+        const T* row = a.data() + static_cast<size_t>(i) * n;
+        T sum = 0;
+#pragma omp simd reduction(+:sum)
+        for (int j = 0; j < i; j++) {
+            sum += row[j] * x[j];
+        }
+        x[i] -= sum;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        const T* row = a.data() + static_cast<size_t>(i) * n;
+        T sum = 0;
+#pragma omp simd reduction(+:sum)
+        for (int j = i + 1; j < n; j++) {
+            sum += row[j] * x[j];
+        }
+        x[i] = (x[i] - sum) / row[i];
+    }
+}
+
+// LU-разложение смешанной точности с итерационным уточнением:
+// разложение выполняется во float, а поправки к решению накапливаются в double
+// по невязке calculateResidual, пока поправка не станет меньше epsilon.
+// Как в LAPACK dsgesv, уточнение прекращается, только если поправка
+// перестала убывать или исчерпано maxRefinements итераций: медленное, но
+// сходящееся уточнение все равно дешевле разложения в double.
+// Возвращает число итераций уточнения или -1, если уточнение не сошлось
+// и система была решена полностью в двойной точности.
+inline int MixedPrecisionLU(const vector<vector<double>>& A,
+                            const vector<double>& b,
+                            vector<double>& x,
+                            double epsilon = EPSILON,
+                            int maxRefinements = 30) {
+    PROFILE_SCOPE("MixedPrecisionLU");
+    int n = A.size();
+    vector<float> LUf(static_cast<size_t>(n) * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            LUf[static_cast<size_t>(i) * n + j] = static_cast<float>(A[i][j]);
+        }
+    }
+
+    // Нулевой или переполненный ведущий элемент во float - уточнять нечего
+    bool factorized = DenseLUDecomposition(LUf, n);
+
+    x.assign(n, 0.0);
+    if (factorized) {
+        vector<double> residual = b; // невязка при x = 0
+        double prevCorrection = INFINITY;
+
+        for (int iteration = 1; iteration <= maxRefinements; iteration++) {
+            vector<float> d(residual.begin(), residual.end());
+            DenseLUSolve(LUf, n, d);
+
+            double correction = 0.0;
+            for (int i = 0; i < n; i++) {
+                x[i] += d[i];
+                correction = max(correction, fabs(static_cast<double>(d[i])));
+            }
+
+            if (correction <= epsilon) {
+                return iteration;
+            }
+            // Поправки не убывают - разложение во float слишком грубое
+            if (!isfinite(correction) || correction >= prevCorrection) {
+                break;
+            }
+            prevCorrection = correction;
+            residual = calculateResidual(A, b, x);
+        }
+    }
+
+    // Запасной путь: полное решение в двойной точности
+    vector<vector<double>> L, U;
+    LUDecomposition(A, L, U);
+    x = BackwardSubstitution(U, ForwardSubstitution(L, b));
+    return -1;
+}
+
+// Итерации метода Зейделя от начального приближения x (без вывода)
+// Возвращает число выполненных итераций; в converged - достигнута ли точность
+// epsilon (по числу итераций не отличить сходимость на последней итерации
+// от остановки по maxIterations)
+inline int SeidelIterations(const vector<vector<double>>& A,
+                            const vector<double>& b,
+                            vector<double>& x,
+                            double epsilon = EPSILON,
+                            int maxIterations = 1000,
+                            bool* converged = nullptr) {
+    PROFILE_SCOPE("SeidelIterations");
+    int n = A.size();
+    vector<double> x_prev(n, 0.0);//предыдущее приближение
+    int iteration = 0;//счетчик итераций
+    double error;
+
+    do {
+        x_prev = x;
+        for (int i = 0; i < n; i++) {
+            double sum = 0.0;
+            for (int j = 0; j < n; j++) {
+                if (j != i) {
+                    sum += A[i][j] * x[j];
+                }
+            }
+            x[i] = (b[i] - sum) / A[i][i];
+        }
+
+        // Вычисление ошибки
+        error = 0.0;
+        for (int i = 0; i < n; i++) {
+            error = max(error, abs(x[i] - x_prev[i]));
+        }
+        iteration++;
+    } while (error > epsilon && iteration < maxIterations); // Условие продолжения
+
+    if (converged) *converged = error <= epsilon;
+    return iteration;
+}
+
+// Метод Зейделя для решения системы линейных уравнений
+inline vector<double> SeidelMethod(const vector<vector<double>>& A,
+                                  const vector<double>& b,
+                                  double epsilon = EPSILON,
+                                  int maxIterations = 1000) {
+    int n = A.size();
+    vector<double> x(n, 0.0);//текущее приближение
+    int iteration = SeidelIterations(A, b, x, epsilon, maxIterations);
+
+    cout << "Метод Зейделя сошелся за " << iteration << " итераций\n";
+    return x;
+}
+
+// Максимальная по модулю невязка (NaN, если решение разошлось)
+inline double maxResidual(const vector<double>& residual) {
+    double max_residual = 0;
+    for (double r : residual) {
+        if (isnan(r)) {
+            return r;
+        }
+        if (fabs(r) > max_residual) {
+            max_residual = fabs(r);
+        }
+    }
+    return max_residual;
+}
+
+// =============================================
+//       Ленточные и трехдиагональные системы
+// =============================================
+
+// Ленточная матрица: хранятся только диагонали от -kl до +ku,
+// O(n * (kl + ku + 1)) памяти вместо O(n^2)
+struct BandMatrix {
+    int n = 0;
+    int kl = 0; // число поддиагоналей
+    int ku = 0; // число наддиагоналей
+    vector<double> data; // строка i: элементы столбцов i-kl .. i+ku
+
+    BandMatrix() = default;
+    BandMatrix(int n, int kl, int ku)
+        : n(n), kl(kl), ku(ku), data(static_cast<size_t>(n) * (kl + ku + 1), 0.0) {}
+
+    double& at(int i, int j) { return data[static_cast<size_t>(i) * (kl + ku + 1) + (j - i + kl)]; }
+    double at(int i, int j) const { return data[static_cast<size_t>(i) * (kl + ku + 1) + (j - i + kl)]; }
+};
+
+// Упаковка плотной матрицы в ленточную с заданными kl и ku
+inline BandMatrix toBandMatrix(const vector<vector<double>>& A, int kl, int ku) {
+    int n = A.size();
+    BandMatrix band(n, kl, ku);
+    for (int i = 0; i < n; i++) {
+        for (int j = max(0, i - kl); j <= min(n - 1, i + ku); j++) {
+            band.at(i, j) = A[i][j];
+        }
+    }
+    return band;
+}
+
+// Ленточное LU-разложение на месте (L с единичной диагональю под диагональю,
+// U на диагонали и выше), O(n * kl * ku) операций.
+// Как и LUDecomposition, выполняется без выбора ведущего элемента;
+// возвращает false при нулевом ведущем элементе.
+inline bool BandedLUDecomposition(BandMatrix& band) {
+    int n = band.n;
+    for (int k = 0; k < n; k++) {
+        double pivot = band.at(k, k);
+        if (pivot == 0.0) {
+            return false;
+        }
+        int lastRow = min(n - 1, k + band.kl);
+        int lastCol = min(n - 1, k + band.ku);
+        for (int i = k + 1; i <= lastRow; i++) {
+            double l = band.at(i, k) / pivot;
+            band.at(i, k) = l;
+            for (int j = k + 1; j <= lastCol; j++) {
+                band.at(i, j) -= l * band.at(k, j);
+            }
+        }
+    }
+    return true;
+}
+
+// Прямая и обратная подстановка для ленточного LU-разложения
+inline vector<double> BandedLUSolve(const BandMatrix& band, const vector<double>& b) {
+    int n = band.n;
+    vector<double> x(b);
+
+    for (int i = 0; i < n; i++) {
+        double sum = 0;
+        for (int j = max(0, i - band.kl); j < i; j++) {
+            sum += band.at(i, j) * x[j];
+        }
+        x[i] -= sum;
+    }
+
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = 0;
+        for (int j = i + 1; j <= min(n - 1, i + band.ku); j++) {
+            sum += band.at(i, j) * x[j];
+        }
+        x[i] = (x[i] - sum) / band.at(i, i);
+    }
+
+    return x;
+}
+
+// Метод прогонки (алгоритм Томаса) для трехдиагональной системы:
+// lower[i] = a[i][i-1], diag[i] = a[i][i], upper[i] = a[i][i+1].
+// Возвращает false при нулевом знаменателе; пустая система решается сразу.
+inline bool ThomasAlgorithm(const vector<double>& lower,
+                            const vector<double>& diag,
+                            const vector<double>& upper,
+                            const vector<double>& rhs,
+                            vector<double>& x) {
+    int n = diag.size();
+    vector<double> c(n, 0.0); // прогоночные коэффициенты
+    x.assign(n, 0.0);
+    if (n == 0) return true;
+
+    double denom = diag[0];
+    if (denom == 0.0) return false;
+    c[0] = n > 1 ? upper[0] / denom : 0.0;
+    x[0] = rhs[0] / denom;
+
+    // Прямой ход
+    for (int i = 1; i < n; i++) {
+        denom = diag[i] - lower[i] * c[i - 1];
+        if (denom == 0.0) return false;
+        c[i] = i + 1 < n ? upper[i] / denom : 0.0;
+        x[i] = (rhs[i] - lower[i] * x[i - 1]) / denom;
+    }
+
+    // Обратный ход
+    for (int i = n - 2; i >= 0; i--) {
+        x[i] -= c[i] * x[i + 1];
+    }
+    return true;
+}
+
+// =============================================
+//     Разложение Холецкого (LL^T) для SPD-матриц
+// =============================================
+
+// Нижний треугольник, упакованный по строкам: элемент (i, j), j <= i,
+// лежит по индексу i*(i+1)/2 + j - n(n+1)/2 чисел вместо n^2
+struct PackedLower {
+    int n = 0;
+    vector<double> data;
+
+    double* row(int i) { return data.data() + static_cast<size_t>(i) * (i + 1) / 2; }
+    const double* row(int i) const { return data.data() + static_cast<size_t>(i) * (i + 1) / 2; }
+};
+
+// Выполнение body(i) для i из [begin, end) на нескольких потоках
+template <typename Body>
+void parallelFor(int begin, int end, int threads, const Body& body) {
+    int count = end - begin;
+    threads = min(threads, count);
+    if (threads <= 1) {
+        for (int i = begin; i < end; i++) body(i);
+        return;
+    }
+
+    vector<thread> pool;
+    int chunk = (count + threads - 1) / threads;
+    for (int t = 0; t < threads; t++) {
+        int from = begin + t * chunk;
+        int to = min(end, from + chunk);
+        if (from >= to) break;
+        pool.emplace_back([from, to, &body]() {
+            for (int i = from; i < to; i++) body(i);
+        });
+    }
+    for (thread& th : pool) th.join();
+}
+
+// Многоразовый барьер для фиксированного числа потоков: wait() возвращается,
+// когда его вызвали все count потоков текущей фазы
+class ThreadBarrier {
+public:
+    explicit ThreadBarrier(int count) : count(count) {}
+
+    void wait() {
+        unique_lock<mutex> lock(m);
+        unsigned long long arrivedPhase = phase;
+        if (++waiting == count) {
+            waiting = 0;
+            phase++;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return phase != arrivedPhase; });
+        }
+    }
+
+private:
+    mutex m;
+    condition_variable cv;
+    int count;
+    int waiting = 0;
+    unsigned long long phase = 0;
+};
+
+// Скалярное произведение первых len элементов двух строк
+inline double dotPrefix(const double* a, const double* b, int len) {
+    double sum = 0;
+    for (int k = 0; k < len; k++) {
+        sum += a[k] * b[k];
+    }
+    return sum;
+}
+
+// Блочное разложение Холецкого A = L L^T (используется нижний треугольник A).
+// Столбцы обрабатываются блоками по blockSize: диагональный блок считается
+// последовательно, строки панели под ним - параллельно на threads потоках
+// (0 - по числу ядер). Потоки создаются один раз на все разложение и
+// синхронизируются барьером после диагонального блока и после панели;
+// потоков не больше, чем блоков в первой панели. Возвращает false, если
+// матрица не положительно определена - тогда следует перейти к LUDecomposition.
+inline bool CholeskyDecomposition(const vector<vector<double>>& A,
+                                  PackedLower& L,
+                                  int threads = 0,
+                                  int blockSize = 64) {
+    int n = A.size();
+    blockSize = max(1, blockSize);
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, (n - blockSize) / blockSize));
+
+    L.n = n;
+    L.data.assign(static_cast<size_t>(n) * (n + 1) / 2, 0.0);
+    for (int i = 0; i < n; i++) {
+        copy(A[i].begin(), A[i].begin() + i + 1, L.row(i));
+    }
+
+    ThreadBarrier barrier(threads);
+    bool failed = false; // пишет поток 0 до барьера, читают все после него
+
+    auto worker = [&](int t) {
+        for (int kb = 0; kb < n; kb += blockSize) {
+            int ke = min(n, kb + blockSize);
+
+            // Диагональный блок
+            if (t == 0) {
+                for (int i = kb; i < ke && !failed; i++) {
+                    double* Li = L.row(i);
+                    for (int j = kb; j <= i; j++) {
+                        const double* Lj = L.row(j);
+                        double sum = dotPrefix(Li, Lj, j);
+                        if (j == i) {
+                            double d = Li[i] - sum;
+                            if (!(d > 0.0)) { // ловит и NaN
+                                failed = true;
+                                break;
+                            }
+                            Li[i] = sqrt(d);
+                        } else {
+                            Li[j] = (Li[j] - sum) / Lj[j];
+                        }
+                    }
+                }
+            }
+            barrier.wait();
+            if (failed) return;
+
+            // Панель под диагональным блоком: строки независимы друг от друга
+            int chunk = (n - ke + threads - 1) / threads;
+            int from = ke + t * chunk, to = min(n, from + chunk);
+            for (int i = from; i < to; i++) {
+                double* Li = L.row(i);
+                for (int j = kb; j < ke; j++) {
+                    const double* Lj = L.row(j);
+                    Li[j] = (Li[j] - dotPrefix(Li, Lj, j)) / Lj[j];
+                }
+            }
+            barrier.wait();
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (thread& th : pool) th.join();
+    return !failed;
+}
+
+// Решение L L^T x = b по упакованному множителю
+inline vector<double> CholeskySolve(const PackedLower& L, const vector<double>& b) {
+    int n = L.n;
+    vector<double> y(b);
+
+    // Ly = b
+    for (int i = 0; i < n; i++) {
+        const double* Li = L.row(i);
+        y[i] = (y[i] - dotPrefix(Li, y.data(), i)) / Li[i];
+    }
+
+    // L^T x = y: обходим L по строкам, вычитая найденное x[i] из остальных
+    for (int i = n - 1; i >= 0; i--) {
+        const double* Li = L.row(i);
+        y[i] /= Li[i];
+        for (int k = 0; k < i; k++) {
+            y[k] -= Li[k] * y[i];
+        }
+    }
+
+    return y;
+}
+
+// =============================================
+//     Анализ структуры и автоматический выбор
+// =============================================
+
+// Структура матрицы, по которой выбирается решатель
+struct MatrixStructure {
+    int lowerBandwidth = 0;        // максимальное i - j для ненулевого a[i][j]
+    int upperBandwidth = 0;        // максимальное j - i для ненулевого a[i][j]
+    bool symmetric = true;
+    bool diagonallyDominant = true; // строгое диагональное преобладание по строкам
+};
+
+inline MatrixStructure analyzeMatrix(const vector<vector<double>>& A) {
+    int n = A.size();
+    MatrixStructure s;
+    for (int i = 0; i < n; i++) {
+        double offDiagonal = 0;
+        for (int j = 0; j < n; j++) {
+            if (A[i][j] != 0.0) {
+                s.lowerBandwidth = max(s.lowerBandwidth, i - j);
+                s.upperBandwidth = max(s.upperBandwidth, j - i);
+            }
+            if (j != i) offDiagonal += fabs(A[i][j]);
+            if (j < i && A[i][j] != A[j][i]) s.symmetric = false;
+        }
+        if (fabs(A[i][i]) <= offDiagonal) s.diagonallyDominant = false;
+    }
+    return s;
+}
+
+// Решение системы самым дешевым подходящим методом:
+// трехдиагональная - прогонка, узкая лента - ленточное LU,
+// диагональное преобладание - метод Зейделя (пока он дешевле прямого метода),
+// симметричная - разложение Холецкого, иначе - LU-разложение. В method записывается имя выбранного метода,
+// в seidelIterations - сколько итераций Зейделя выполнено (и при неудачной попытке)
+inline vector<double> SolveAuto(const vector<vector<double>>& A,
+                                const vector<double>& b,
+                                string* method = nullptr,
+                                int* seidelIterations = nullptr) {
+    int n = A.size();
+    if (seidelIterations) *seidelIterations = 0;
+    MatrixStructure s = analyzeMatrix(A);
+    vector<double> x;
+
+    if (s.lowerBandwidth <= 1 && s.upperBandwidth <= 1) {
+        vector<double> lower(n, 0.0), diag(n), upper(n, 0.0);
+        for (int i = 0; i < n; i++) {
+            diag[i] = A[i][i];
+            if (i > 0) lower[i] = A[i][i - 1];
+            if (i + 1 < n) upper[i] = A[i][i + 1];
+        }
+        if (ThomasAlgorithm(lower, diag, upper, b, x)) {
+            if (method) *method = "thomas";
+            return x;
+        }
+    }
+
+    if (2 * (s.lowerBandwidth + s.upperBandwidth) < n) {
+        BandMatrix band = toBandMatrix(A, s.lowerBandwidth, s.upperBandwidth);
+        if (BandedLUDecomposition(band)) {
+            if (method) *method = "banded_lu";
+            return BandedLUSolve(band, b);
+        }
+    }
+
+    if (s.diagonallyDominant) {
+        // Итерация Зейделя стоит ~2n^2, LU - ~2/3 n^3, Холецкий - ~1/3 n^3:
+        // метод выгоден, пока сходится быстрее чем за n/3 (n/6) итераций
+        int budget = max(1, s.symmetric ? n / 6 : n / 3);
+        x.assign(n, 0.0);
+        bool converged = false;
+        int iterations = SeidelIterations(A, b, x, EPSILON, budget, &converged);
+        if (seidelIterations) *seidelIterations = iterations;
+        if (converged) {
+            if (method) *method = "seidel";
+            return x;
+        }
+    }
+
+    if (s.symmetric) {
+        PackedLower C;
+        if (CholeskyDecomposition(A, C)) {
+            if (method) *method = "cholesky";
+            return CholeskySolve(C, b);
+        }
+    }
+
+    vector<vector<double>> L, U;
+    LUDecomposition(A, L, U);
+    if (method) *method = "lu";
+    return BackwardSubstitution(U, ForwardSubstitution(L, b));
+}
+
+#endif // LINEAR_SOLVERS_H
@@ -0,0 +1,146 @@
+#ifndef MATRIX_GEN_H
+#define MATRIX_GEN_H
+
+// Генерация случайных матриц и досок (laba6_11.cpp, laba6_12.cpp, laba6_5.cpp).
+// Вместо общего состояния rand() используется счетный генератор Philox4x32-10:
+// i-е случайное число - это функция только от (seed, i). Поэтому матрицу можно
+// заполнять параллельно любым числом потоков, а результат при одном seed
+// всегда одинаковый. Пачки счетчиков обрабатываются в массивах-дорожках,
+// которые компилятор превращает в векторные инструкции.
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include <cstddef>
+
+#include "row_scan.h"
+
+using namespace std;
+
+// Число счетчиков Philox, обрабатываемых за один проход (одна "пачка")
+const int PHILOX_LANES = 8;
+
+// Пачка из PHILOX_LANES 128-битных счетчиков по 32-битным словам
+struct PhiloxLanes {
+    alignas(32) uint32_t c0[PHILOX_LANES];
+    alignas(32) uint32_t c1[PHILOX_LANES];
+    alignas(32) uint32_t c2[PHILOX_LANES];
+    alignas(32) uint32_t c3[PHILOX_LANES];
+};
+
+// 10 раундов Philox4x32 над всей пачкой сразу.
+// На входе - счетчики, на выходе - случайные 32-битные слова.
+inline void philox4x32Lanes(PhiloxLanes& x, uint64_t seed) {
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    uint32_t k0 = static_cast<uint32_t>(seed);
+    uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int l = 0; l < PHILOX_LANES; ++l) {
+            uint64_t p0 = static_cast<uint64_t>(M0) * x.c0[l];
+            uint64_t p1 = static_cast<uint64_t>(M1) * x.c2[l];
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ x.c1[l] ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ x.c3[l] ^ k1;
+            x.c0[l] = n0;
+            x.c1[l] = static_cast<uint32_t>(p1);
+            x.c2[l] = n2;
+            x.c3[l] = static_cast<uint32_t>(p0);
+        }
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+// Случайные 64-битные слова с номерами [first, first + count): слово i - это
+// половина выхода Philox для счетчика i / 2
+inline void randomWords(uint64_t* out, uint64_t first, size_t count, uint64_t seed) {
+    uint64_t end = first + count;
+    for (uint64_t counter = first / 2; counter * 2 < end; counter += PHILOX_LANES) {
+        PhiloxLanes x;
+        for (int l = 0; l < PHILOX_LANES; ++l) {
+            x.c0[l] = static_cast<uint32_t>(counter + l);
+            x.c1[l] = static_cast<uint32_t>((counter + l) >> 32);
+            x.c2[l] = 0;
+            x.c3[l] = 0;
+        }
+        philox4x32Lanes(x, seed);
+
+        for (int l = 0; l < PHILOX_LANES; ++l) {
+            uint64_t word = (counter + l) * 2;
+            if (word >= first && word < end) {
+                out[word - first] = (static_cast<uint64_t>(x.c1[l]) << 32) | x.c0[l];
+            }
+            if (word + 1 >= first && word + 1 < end) {
+                out[word + 1 - first] = (static_cast<uint64_t>(x.c3[l]) << 32) | x.c2[l];
+            }
+        }
+    }
+}
+
+// Выполнение body(from, to) над кусками [0, n), выровненными на align элементов
+template <typename Body>
+void parallelChunks(size_t n, size_t align, int threads, const Body& body) {
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    size_t chunk = (n + threads - 1) / threads;
+    chunk = (chunk + align - 1) / align * align;
+    if (threads == 1 || chunk >= n) {
+        body(0, n);
+        return;
+    }
+
+    vector<thread> pool;
+    for (size_t from = 0; from < n; from += chunk) {
+        size_t to = min(n, from + chunk);
+        pool.emplace_back([from, to, &body]() { body(from, to); });
+    }
+    for (thread& th : pool) th.join();
+}
+
+// Заполнение values[0, n) равномерными целыми из [lo, hi].
+// Отображение слова в диапазон - умножение 64x64 -> 128 со взятием старшей
+// половины: без деления и со смещением порядка (hi - lo + 1) / 2^64
+// вместо заметного смещения rand() % m.
+inline void fillUniformInt(int* values, size_t n, int lo, int hi, uint64_t seed, int threads = 0) {
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+    parallelChunks(n, 1024, threads, [=](size_t from, size_t to) {
+        uint64_t words[1024];
+        for (size_t base = from; base < to; base += 1024) {
+            size_t count = min<size_t>(1024, to - base);
+            randomWords(words, base, count, seed);
+            for (size_t i = 0; i < count; ++i) {
+                uint64_t offset = static_cast<uint64_t>((static_cast<unsigned __int128>(words[i]) * range) >> 64);
+                values[base + i] = static_cast<int>(lo + static_cast<int64_t>(offset));
+            }
+        }
+    });
+}
+
+// Случайная матрица rows x cols с элементами из [lo, hi]
+inline IntMatrix randomMatrix(int rows, int cols, int lo, int hi, uint64_t seed, int threads = 0) {
+    IntMatrix matrix(rows, cols);
+    fillUniformInt(matrix.data.data(), matrix.data.size(), lo, hi, seed, threads);
+    return matrix;
+}
+
+// Случайные биты для досок из 0/1: одно 64-битное слово - 64 клетки
+inline void fillRandomBits(uint64_t* words, size_t count, uint64_t seed, int threads = 0) {
+    parallelChunks(count, 1024, threads, [=](size_t from, size_t to) {
+        randomWords(words + from, from, to - from, seed);
+    });
+}
+
+// Бит номер i последовательности fillRandomBits
+inline int randomBit(const vector<uint64_t>& words, size_t i) {
+    return static_cast<int>((words[i / 64] >> (i % 64)) & 1);
+}
+
+// Seed по умолчанию - из аппаратного источника энтропии
+inline uint64_t randomSeed() {
+    random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+#endif // MATRIX_GEN_H
@@ -0,0 +1,269 @@
+#ifndef MATRIX_STREAM_H
+#define MATRIX_STREAM_H
+
+// Потоковая обработка матриц из файла для laba6_11.cpp и laba6_12.cpp:
+// за один проход считаются положительные числа в каждой строке, строка
+// с наибольшим их количеством и частоты значений. В памяти держится только
+// текущая и лучшая строки, поэтому размер файла может превышать объем ОЗУ.
+//
+// Форматы файла:
+//  - двоичный: "IMAT", uint32 rows, uint32 cols, затем rows*cols int32
+//    по строкам (порядок байт - как у машины); читается через mmap;
+//  - текстовый (CSV): по строке матрицы на строке файла, числа разделены
+//    запятыми, пробелами, табуляциями или точкой с запятой.
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <charconv>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "row_scan.h"
+#include "frequency.h"
+#include "heavy_hitters.h"
+#include "fast_output.h"
+
+using namespace std;
+
+// Статистика, накопленная за один проход
+struct MatrixStreamStats {
+    long long rows = 0;
+    int cols = 0;
+    vector<int> positivesPerRow;       // количество положительных в каждой строке
+    RowScanResult bestRow;             // строка с наибольшим их количеством
+    vector<int> bestRowValues;         // копия этой строки (одна строка)
+    FrequencyCounter frequency;        // частоты значений
+};
+
+// Накопитель статистики: получает матрицу по одной строке
+class MatrixStatsAccumulator {
+public:
+    // printTo != nullptr - строки дополнительно выводятся как в исходных
+    // программах (элементы через табуляцию)
+    explicit MatrixStatsAccumulator(ostream* printTo = nullptr)
+        : printed(printTo ? *printTo : cout), print(printTo != nullptr),
+          countPositive(selectCountPositive()) {}
+
+    // Известный заранее диапазон значений - частоты считаются плоским
+    // массивом вместо хеш-таблицы (вызывать до первой строки)
+    void setValueRange(int minValue, int maxValue) {
+        stats.frequency = FrequencyCounter(minValue, maxValue);
+    }
+
+    // Приближенный режим: частоты вместо точного счетчика накапливаются
+    // в эскизе фиксированного размера
+    void setApproximate(HeavyHittersSketch* sketch) {
+        approx = sketch;
+    }
+
+    // Возвращает false, если длина строки отличается от первой строки
+    bool addRow(const int* row, int n) {
+        if (stats.rows == 0) {
+            stats.cols = n;
+        } else if (n != stats.cols) {
+            return false;
+        }
+
+        int countPos = countPositive(row, n);
+        stats.positivesPerRow.push_back(countPos);
+        if (countPos > stats.bestRow.count) {
+            stats.bestRow.count = countPos;
+            stats.bestRow.index = static_cast<int>(stats.rows);
+            stats.bestRowValues.assign(row, row + n);
+        }
+
+        if (approx) approx->add(row, n);
+        else stats.frequency.add(row, n);
+
+        if (print) {
+            for (int j = 0; j < n; ++j) {
+                printed.integer(row[j]);
+                printed.put('\t');
+            }
+            printed.put('\n');
+        }
+
+        ++stats.rows;
+        return true;
+    }
+
+    // Передача выведенных строк в поток; вызывается в конце прохода
+    void flushPrinted() {
+        printed.flush();
+    }
+
+    MatrixStreamStats stats;
+
+private:
+    FastOutput printed;
+    bool print;
+    CountPositiveFn countPositive;
+    HeavyHittersSketch* approx = nullptr;
+};
+
+const char MATRIX_BINARY_MAGIC[4] = {'I', 'M', 'A', 'T'};
+
+// Сохранение матрицы в двоичном формате
+inline bool saveMatrixBinary(const string& path, const IntMatrix& matrix) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    uint32_t rows = matrix.rows, cols = matrix.cols;
+    out.write(MATRIX_BINARY_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    out.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    out.write(reinterpret_cast<const char*>(matrix.data.data()),
+              static_cast<streamsize>(matrix.data.size() * sizeof(int)));
+    return static_cast<bool>(out);
+}
+
+// Двоичный файл: отображается в память, строки передаются без копирования
+inline bool streamBinaryMatrix(int fd, size_t fileSize, MatrixStatsAccumulator& acc, string& error) {
+    const size_t headerSize = 4 + 2 * sizeof(uint32_t);
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        error = "не удалось отобразить файл в память";
+        return false;
+    }
+    madvise(mapped, fileSize, MADV_SEQUENTIAL);
+
+    const char* bytes = static_cast<const char*>(mapped);
+    uint32_t rows, cols;
+    memcpy(&rows, bytes + 4, sizeof(rows));
+    memcpy(&cols, bytes + 8, sizeof(cols));
+
+    // Размер данных проверяется делением: rows * cols из заголовка может
+    // переполнить size_t. Пустая матрица не дает строк, как пустой текстовый файл
+    bool ok = true;
+    if (cols > static_cast<uint32_t>(INT_MAX)) {
+        error = "слишком много столбцов в заголовке";
+        ok = false;
+    } else if (rows == 0 || cols == 0) {
+        ok = true;
+    } else if (rows > (fileSize - headerSize) / sizeof(int) / cols) {
+        error = "файл короче, чем указано в заголовке";
+        ok = false;
+    } else {
+        const int* data = reinterpret_cast<const int*>(bytes + headerSize);
+        for (uint32_t i = 0; i < rows; ++i) {
+            acc.addRow(data + static_cast<size_t>(i) * cols, static_cast<int>(cols));
+        }
+    }
+
+    munmap(mapped, fileSize);
+    return ok;
+}
+
+// Разбор одной строки текста в row; false при некорректном числе
+inline bool parseMatrixLine(const char* begin, const char* end, vector<int>& row) {
+    row.clear();
+    const char* p = begin;
+    while (p < end) {
+        char c = *p;
+        if (c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r') {
+            ++p;
+            continue;
+        }
+        if (c == '+') ++p; // from_chars не принимает знак "+"
+        int value;
+        auto result = from_chars(p, end, value);
+        if (result.ec != errc()) return false;
+        row.push_back(value);
+        p = result.ptr;
+    }
+    return true;
+}
+
+// Текстовый файл: читается блоками фиксированного размера; буфер растет
+// только если одна строка файла длиннее блока
+inline bool streamTextMatrix(int fd, MatrixStatsAccumulator& acc, string& error) {
+    vector<char> buffer(1 << 20);
+    vector<int> row;
+    size_t filled = 0;
+    long long lineNumber = 0;
+    bool eof = false;
+
+    while (!eof || filled > 0) {
+        if (!eof) {
+            if (filled == buffer.size()) buffer.resize(buffer.size() * 2);
+            ssize_t got = read(fd, buffer.data() + filled, buffer.size() - filled);
+            if (got < 0) {
+                error = "ошибка чтения файла";
+                return false;
+            }
+            if (got == 0) eof = true;
+            filled += static_cast<size_t>(got);
+        }
+
+        // Обрабатываются только полные строки; остаток переносится в начало
+        const char* begin = buffer.data();
+        const char* end = begin + filled;
+        const char* lastNewline = nullptr;
+        for (const char* p = end; p > begin; --p) {
+            if (p[-1] == '\n') {
+                lastNewline = p - 1;
+                break;
+            }
+        }
+        const char* limit = lastNewline ? lastNewline + 1 : (eof ? end : begin);
+
+        const char* line = begin;
+        while (line < limit) {
+            const char* lineEnd = static_cast<const char*>(memchr(line, '\n', limit - line));
+            if (!lineEnd) lineEnd = limit;
+            ++lineNumber;
+
+            if (!parseMatrixLine(line, lineEnd, row)) {
+                error = "некорректное число в строке " + to_string(lineNumber);
+                return false;
+            }
+            if (!row.empty() && !acc.addRow(row.data(), static_cast<int>(row.size()))) {
+                error = "строка " + to_string(lineNumber) + " имеет другую длину";
+                return false;
+            }
+            line = lineEnd + 1;
+        }
+
+        size_t consumed = limit - begin;
+        memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+        if (eof && consumed == 0) break;
+    }
+    return true;
+}
+
+// Обработка файла матрицы; формат определяется по сигнатуре "IMAT"
+inline bool streamMatrixFile(const string& path, MatrixStatsAccumulator& acc, string& error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "не удалось открыть файл " + path;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error = "не удалось получить размер файла " + path;
+        close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(st.st_size);
+
+    char magic[4] = {};
+    bool binary = fileSize >= 12 && pread(fd, magic, 4, 0) == 4
+                  && memcmp(magic, MATRIX_BINARY_MAGIC, 4) == 0;
+
+    bool ok = binary ? streamBinaryMatrix(fd, fileSize, acc, error)
+                     : streamTextMatrix(fd, acc, error);
+    acc.flushPrinted();
+    close(fd);
+    return ok;
+}
+
+#endif // MATRIX_STREAM_H
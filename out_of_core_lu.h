@@ -0,0 +1,516 @@
+#ifndef OUT_OF_CORE_LU_H
+#define OUT_OF_CORE_LU_H
+
+// LU-разложение матриц, которые не помещаются в память (laba6_3_bench.cpp --out-of-core).
+// Матрица хранится в файле по плиткам tile x tile: плитка (I, J) - непрерывный
+// участок файла, внутри по строкам. В памяти находится только пул из
+// нескольких плиток; при нехватке места вытесняется плитка, которая дольше
+// всех не использовалась (LRU), а измененные плитки записываются обратно.
+// Пока считается текущая плитка, поток подкачки читает следующие.
+//
+// Как и LUDecomposition, разложение идет без выбора ведущего элемента.
+// L (с единичной диагональю) и U записываются на место A. Прямая и обратная
+// подстановки проходят по тем же плиткам, поэтому в памяти достаточно держать
+// вектор правой части.
+// На шаге k строка плиток (k, J) используется для каждой строки ниже, поэтому
+// пул желательно делать не меньше чем на tiles + 4 плитки; минимум - 4.
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "linear_solvers.h"
+
+using namespace std;
+
+// =============================================
+//      Файл плиток
+// =============================================
+
+class TileFile {
+public:
+    int n = 0;      // порядок матрицы
+    int tile = 0;   // сторона плитки
+    int tiles = 0;  // число плиток по стороне
+
+    // Создает (или обрезает) файл path нужного размера, заполненный нулями.
+    // removeOnClose - удалить файл в деструкторе (временная матрица)
+    TileFile(const string& path, int n, int tile, bool removeOnClose = true)
+        : n(n), tile(tile), tiles((n + tile - 1) / tile), path(path), removeOnClose(removeOnClose) {
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0 && ftruncate(fd, static_cast<off_t>(tileBytes() * tiles * tiles)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    ~TileFile() {
+        if (fd >= 0) close(fd);
+        if (removeOnClose) unlink(path.c_str());
+    }
+
+    TileFile(const TileFile&) = delete;
+    TileFile& operator=(const TileFile&) = delete;
+
+    bool ok() const { return fd >= 0; }
+    size_t tileElements() const { return static_cast<size_t>(tile) * tile; }
+    size_t tileBytes() const { return tileElements() * sizeof(double); }
+    int id(int I, int J) const { return I * tiles + J; }
+
+    bool readTile(int id, double* dst) const { return transfer(id, dst, false); }
+    bool writeTile(int id, const double* src) const { return transfer(id, const_cast<double*>(src), true); }
+
+private:
+    string path;
+    bool removeOnClose;
+    int fd = -1;
+
+    // pread/pwrite могут передать меньше запрошенного - повторяем до конца плитки
+    bool transfer(int id, double* data, bool write) const {
+        char* p = reinterpret_cast<char*>(data);
+        size_t left = tileBytes();
+        off_t offset = static_cast<off_t>(tileBytes() * id);
+        while (left > 0) {
+            ssize_t done = write ? pwrite(fd, p, left, offset) : pread(fd, p, left, offset);
+            if (done <= 0) return false;
+            p += done;
+            offset += done;
+            left -= static_cast<size_t>(done);
+        }
+        return true;
+    }
+};
+
+// =============================================
+//      Пул плиток с вытеснением LRU и подкачкой
+// =============================================
+
+struct TilePoolStats {
+    long long hits = 0;       // плитка уже была в пуле
+    long long misses = 0;     // плитку пришлось читать при обращении
+    long long prefetched = 0; // плитки, прочитанные потоком подкачки
+    long long reads = 0;
+    long long writes = 0;
+    bool ioError = false;
+};
+
+class TilePool {
+public:
+    TilePool(TileFile& file, size_t capacity)
+        : file(file), frames(max<size_t>(capacity, 4)) {
+        for (Frame& f : frames) f.data.resize(file.tileElements());
+        prefetcher = thread([this]() { prefetchLoop(); });
+    }
+
+    ~TilePool() {
+        {
+            lock_guard<mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        prefetcher.join();
+        flush();
+    }
+
+    // Плитка закрепляется в пуле до unpin (при необходимости читается из файла)
+    double* pin(int id) { return acquire(id, true, true); }
+
+    // dirty - плитка изменена и при вытеснении должна быть записана
+    void unpin(int id, bool dirty) {
+        lock_guard<mutex> lock(m);
+        Frame& f = frames[where.at(id)];
+        f.dirty = f.dirty || dirty;
+        --f.pins;
+        cv.notify_all();
+    }
+
+    // Просьба прочитать плитку заранее (не ждет и не закрепляет)
+    void prefetch(int id) {
+        {
+            lock_guard<mutex> lock(m);
+            if (where.count(id)) return;
+            // Устаревшие просьбы отбрасываются, если подкачка не успевает
+            if (prefetchQueue.size() >= frames.size()) prefetchQueue.pop_front();
+            prefetchQueue.push_back(id);
+        }
+        cv.notify_all();
+    }
+
+    // Запись всех измененных плиток в файл
+    void flush() {
+        lock_guard<mutex> lock(m);
+        for (Frame& f : frames) {
+            if (f.id >= 0 && f.dirty && !f.loading) {
+                if (!file.writeTile(f.id, f.data.data())) stats.ioError = true;
+                ++stats.writes;
+                f.dirty = false;
+            }
+        }
+    }
+
+    size_t capacity() const { return frames.size(); }
+    TilePoolStats statistics() {
+        lock_guard<mutex> lock(m);
+        return stats;
+    }
+
+private:
+    struct Frame {
+        int id = -1;
+        vector<double> data;
+        int pins = 0;
+        bool dirty = false;
+        bool loading = false; // идет запись старой или чтение новой плитки
+        uint64_t lastUse = 0;
+    };
+
+    TileFile& file;
+    vector<Frame> frames;
+    unordered_map<int, size_t> where;  // плитка -> кадр
+    unordered_set<int> evicting;       // вытесненные плитки, запись которых не закончена
+    deque<int> prefetchQueue;
+    uint64_t clock = 0;
+    TilePoolStats stats;
+    bool stopping = false;
+    mutex m;
+    condition_variable cv;
+    thread prefetcher;
+
+    // Незакрепленный кадр, использованный раньше всех (-1, если все заняты)
+    long long victim() const {
+        long long best = -1;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            const Frame& f = frames[i];
+            if (f.pins > 0 || f.loading) continue;
+            if (f.id < 0) return static_cast<long long>(i);
+            if (best < 0 || f.lastUse < frames[best].lastUse) best = static_cast<long long>(i);
+        }
+        return best;
+    }
+
+    // wait = false - не ждать освобождения кадров (для подкачки)
+    double* acquire(int id, bool pinFrame, bool wait) {
+        unique_lock<mutex> lock(m);
+        while (true) {
+            if (evicting.count(id)) {
+                cv.wait(lock);
+                continue;
+            }
+            auto it = where.find(id);
+            if (it != where.end()) {
+                Frame& f = frames[it->second];
+                if (!wait) return nullptr;
+                if (f.loading) {
+                    cv.wait(lock);
+                    continue;
+                }
+                if (pinFrame) ++f.pins;
+                f.lastUse = ++clock;
+                ++stats.hits;
+                return f.data.data();
+            }
+
+            long long v = victim();
+            if (v < 0) {
+                if (!wait) return nullptr;
+                cv.wait(lock);
+                continue;
+            }
+
+            // Ввод-вывод идет без блокировки: кадр помечен loading,
+            // а старая плитка - в evicting, пока не записана
+            Frame& f = frames[v];
+            int old = f.id;
+            bool writeBack = old >= 0 && f.dirty;
+            if (old >= 0) where.erase(old);
+            if (writeBack) evicting.insert(old);
+            f.id = id;
+            f.loading = true;
+            f.dirty = false;
+            f.pins = pinFrame ? 1 : 0;
+            f.lastUse = ++clock;
+            where[id] = static_cast<size_t>(v);
+            if (wait) ++stats.misses;
+            else ++stats.prefetched;
+            lock.unlock();
+
+            bool ok = true;
+            if (writeBack) ok = file.writeTile(old, f.data.data());
+            ok = file.readTile(id, f.data.data()) && ok;
+
+            lock.lock();
+            if (writeBack) {
+                evicting.erase(old);
+                ++stats.writes;
+            }
+            ++stats.reads;
+            if (!ok) stats.ioError = true;
+            f.loading = false;
+            cv.notify_all();
+            return f.data.data();
+        }
+    }
+
+    void prefetchLoop() {
+        unique_lock<mutex> lock(m);
+        while (true) {
+            cv.wait(lock, [this]() { return stopping || !prefetchQueue.empty(); });
+            if (stopping) return;
+            int id = prefetchQueue.front();
+            prefetchQueue.pop_front();
+            lock.unlock();
+            acquire(id, false, false);
+            lock.lock();
+        }
+    }
+};
+
+// =============================================
+//      Операции над плитками (по строкам, сторона t)
+// =============================================
+
+// LU-разложение диагональной плитки на месте; false при нулевом ведущем элементе
+inline bool factorTile(double* A, int t) {
+    for (int k = 0; k < t; k++) {
+        double pivot = A[static_cast<size_t>(k) * t + k];
+        if (pivot == 0.0 || isnan(pivot)) return false;
+        for (int i = k + 1; i < t; i++) {
+            double* Ai = A + static_cast<size_t>(i) * t;
+            Ai[k] /= pivot;
+            const double* Ak = A + static_cast<size_t>(k) * t;
+            for (int j = k + 1; j < t; j++) Ai[j] -= Ai[k] * Ak[j];
+        }
+    }
+    return true;
+}
+
+// B = L^-1 B, L - нижний треугольник LU с единичной диагональю
+inline void solveLowerTile(const double* LU, double* B, int t) {
+    for (int i = 1; i < t; i++) {
+        double* Bi = B + static_cast<size_t>(i) * t;
+        for (int k = 0; k < i; k++) {
+            double l = LU[static_cast<size_t>(i) * t + k];
+            const double* Bk = B + static_cast<size_t>(k) * t;
+            for (int j = 0; j < t; j++) Bi[j] -= l * Bk[j];
+        }
+    }
+}
+
+// B = B U^-1, U - верхний треугольник LU; строки B независимы
+inline void solveUpperTile(const double* LU, double* B, int t, int threads) {
+    parallelFor(0, t, threads, [&](int r) {
+        double* Br = B + static_cast<size_t>(r) * t;
+        for (int k = 0; k < t; k++) {
+            const double* Uk = LU + static_cast<size_t>(k) * t;
+            Br[k] /= Uk[k];
+            for (int j = k + 1; j < t; j++) Br[j] -= Br[k] * Uk[j];
+        }
+    });
+}
+
+// C -= A B; строки C делятся между потоками
+inline void subtractProductTile(double* C, const double* A, const double* B, int t, int threads) {
+    parallelFor(0, t, threads, [&](int i) {
+        double* Ci = C + static_cast<size_t>(i) * t;
+        const double* Ai = A + static_cast<size_t>(i) * t;
+        for (int k = 0; k < t; k++) {
+            double a = Ai[k];
+            if (a == 0.0) continue;
+            const double* Bk = B + static_cast<size_t>(k) * t;
+            for (int j = 0; j < t; j++) Ci[j] -= a * Bk[j];
+        }
+    });
+}
+
+// =============================================
+//      Матрица во внешней памяти
+// =============================================
+
+class OutOfCoreMatrix {
+public:
+    // poolTiles - сколько плиток держать в памяти, threads - потоки для
+    // вычислений внутри плитки (0 - по числу ядер)
+    OutOfCoreMatrix(const string& path, int n, int tile, size_t poolTiles, int threads = 0)
+        : file(path, n, tile), pool(file, poolTiles),
+          threads(threads > 0 ? threads : max(1u, thread::hardware_concurrency())) {}
+
+    bool ok() const { return file.ok(); }
+    int size() const { return file.n; }
+    TilePoolStats statistics() { return pool.statistics(); }
+
+    // Запись матрицы поэлементно: element(i, j) вызывается по плиткам.
+    // Дополнение до целого числа плиток - единичная матрица, разложение его не портит
+    template <typename Element>
+    void fill(Element element) {
+        int n = file.n, t = file.tile;
+        for (int I = 0; I < file.tiles; I++) {
+            for (int J = 0; J < file.tiles; J++) {
+                double* T = pool.pin(file.id(I, J));
+                for (int r = 0; r < t; r++) {
+                    int i = I * t + r;
+                    for (int c = 0; c < t; c++) {
+                        int j = J * t + c;
+                        T[static_cast<size_t>(r) * t + c] =
+                            (i < n && j < n) ? element(i, j) : (i == j ? 1.0 : 0.0);
+                    }
+                }
+                pool.unpin(file.id(I, J), true);
+            }
+        }
+    }
+
+    void fill(const vector<vector<double>>& A) {
+        fill([&A](int i, int j) { return A[i][j]; });
+    }
+
+    // Плиточное LU-разложение на месте; false при нулевом ведущем элементе
+    bool factorize() {
+        int nt = file.tiles, t = file.tile;
+        for (int k = 0; k < nt; k++) {
+            // Порядок обращений шага k известен заранее, по нему идет подкачка
+            vector<TileOp> ops;
+            ops.push_back({DIAGONAL, k, k});
+            for (int j = k + 1; j < nt; j++) ops.push_back({ROW, k, j});
+            for (int i = k + 1; i < nt; i++) {
+                ops.push_back({COLUMN, i, k});
+                for (int j = k + 1; j < nt; j++) ops.push_back({UPDATE, i, j});
+            }
+            if (k + 1 < nt) ops.push_back({DIAGONAL, k + 1, k + 1}); // только для подкачки
+
+            size_t count = ops.size() - (k + 1 < nt ? 1 : 0);
+            for (size_t p = 0; p < count; p++) {
+                prefetchOps(ops, p + 1, k);
+                const TileOp& op = ops[p];
+                int kk = file.id(k, k), target = file.id(op.i, op.j);
+                switch (op.kind) {
+                case DIAGONAL: {
+                    double* D = pool.pin(kk);
+                    bool ok = factorTile(D, t);
+                    pool.unpin(kk, true);
+                    if (!ok) return false;
+                    break;
+                }
+                case ROW: {
+                    const double* D = pool.pin(kk);
+                    solveLowerTile(D, pool.pin(target), t);
+                    pool.unpin(target, true);
+                    pool.unpin(kk, false);
+                    break;
+                }
+                case COLUMN: {
+                    const double* D = pool.pin(kk);
+                    solveUpperTile(D, pool.pin(target), t, threads);
+                    pool.unpin(target, true);
+                    pool.unpin(kk, false);
+                    break;
+                }
+                case UPDATE: {
+                    int left = file.id(op.i, k), up = file.id(k, op.j);
+                    const double* A = pool.pin(left);
+                    const double* B = pool.pin(up);
+                    subtractProductTile(pool.pin(target), A, B, t, threads);
+                    pool.unpin(target, true);
+                    pool.unpin(up, false);
+                    pool.unpin(left, false);
+                    break;
+                }
+                }
+            }
+        }
+        pool.flush();
+        return !pool.statistics().ioError;
+    }
+
+    // Решение LU x = b по разложенной матрице: прямая подстановка идет по
+    // строкам плиток сверху вниз, обратная - снизу вверх
+    vector<double> solve(const vector<double>& b) {
+        int n = file.n, nt = file.tiles, t = file.tile;
+        vector<double> x(static_cast<size_t>(nt) * t, 0.0);
+        copy(b.begin(), b.end(), x.begin());
+
+        // Ly = b
+        for (int I = 0; I < nt; I++) {
+            double* xI = x.data() + static_cast<size_t>(I) * t;
+            for (int J = 0; J <= I; J++) {
+                if (J < I) pool.prefetch(file.id(I, J + 1));
+                else if (I + 1 < nt) pool.prefetch(file.id(I + 1, 0));
+                int id = file.id(I, J);
+                const double* T = pool.pin(id);
+                if (J < I) {
+                    multiplySubtract(T, x.data() + static_cast<size_t>(J) * t, xI, t);
+                } else {
+                    for (int r = 1; r < t; r++)
+                        xI[r] -= dotPrefix(T + static_cast<size_t>(r) * t, xI, r);
+                }
+                pool.unpin(id, false);
+            }
+        }
+
+        // Ux = y
+        for (int I = nt - 1; I >= 0; I--) {
+            double* xI = x.data() + static_cast<size_t>(I) * t;
+            for (int J = nt - 1; J >= I; J--) {
+                if (J > I) pool.prefetch(file.id(I, J - 1));
+                else if (I > 0) pool.prefetch(file.id(I - 1, nt - 1));
+                int id = file.id(I, J);
+                const double* T = pool.pin(id);
+                if (J > I) {
+                    multiplySubtract(T, x.data() + static_cast<size_t>(J) * t, xI, t);
+                } else {
+                    for (int r = t - 1; r >= 0; r--) {
+                        const double* Tr = T + static_cast<size_t>(r) * t;
+                        double sum = 0;
+                        for (int c = r + 1; c < t; c++) sum += Tr[c] * xI[c];
+                        xI[r] = (xI[r] - sum) / Tr[r];
+                    }
+                }
+                pool.unpin(id, false);
+            }
+        }
+
+        x.resize(n);
+        return x;
+    }
+
+private:
+    enum TileOpKind { DIAGONAL, ROW, COLUMN, UPDATE };
+    struct TileOp {
+        TileOpKind kind;
+        int i, j;
+    };
+
+    TileFile file;
+    TilePool pool;
+    int threads;
+
+    // y -= T v для плитки T
+    static void multiplySubtract(const double* T, const double* v, double* y, int t) {
+        for (int r = 0; r < t; r++) y[r] -= dotPrefix(T + static_cast<size_t>(r) * t, v, t);
+    }
+
+    // Подкачка плиток операции ops[p]: двух множителей обновления и самой плитки
+    void prefetchOps(const vector<TileOp>& ops, size_t p, int k) {
+        if (p >= ops.size()) return;
+        const TileOp& op = ops[p];
+        if (op.kind == UPDATE) {
+            pool.prefetch(file.id(op.i, k));
+            pool.prefetch(file.id(k, op.j));
+        }
+        pool.prefetch(file.id(op.i, op.j));
+    }
+};
+
+#endif // OUT_OF_CORE_LU_H
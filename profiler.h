@@ -0,0 +1,367 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Профилирование горячих участков всех программ (сборка с -DLABA6_PROFILE=ON).
+// PROFILE_SCOPE("имя") в начале функции замеряет время до выхода из нее
+// счетчиком тактов процессора (rdtsc) и добавляет его к фазе с этим именем.
+// Замер стоит десятки тактов, поэтому области ставятся на целые операции
+// (AES_CBC_encrypt, aesCbcEncryptBatch), а не на функции, вызываемые для
+// каждого блока или элемента.
+// Без LABA6_PROFILE макрос пустой, и в обычной сборке не остается ни кода,
+// ни данных профилировщика.
+//
+// Переменные окружения профилирующей сборки:
+//   LABA6_PROFILE_OUT      - файл сводки по фазам в JSON (по умолчанию
+//                            laba6_profile.json в текущем каталоге)
+//   LABA6_PROFILE_TRACE    - файл трассы в формате Chrome (chrome://tracing,
+//                            Perfetto): каждый вызов - отдельное событие
+//   LABA6_PROFILE_COUNTERS - 1: аппаратные счетчики perf_event_open (такты,
+//                            инструкции, промахи кеша, ошибки предсказания
+//                            переходов). Каждый замер - системный вызов read
+//                            (~1 мкс), поэтому для фаз из коротких вызовов
+//                            (expandKey) время лучше брать из прогона
+//                            без счетчиков. Если ядро запрещает счетчики,
+//                            они молча отключаются ("counters": false).
+// Файлы записываются при завершении программы. Фазы вложены, время каждой
+// включает время вложенных.
+
+#ifdef LABA6_PROFILE
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_RDTSC 1
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PROFILER_PERF 1
+#endif
+
+using namespace std;
+
+// Такты (rdtsc) или, где его нет, наносекунды steady_clock
+inline uint64_t profileTicks() {
+#ifdef PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Аппаратные счетчики: такты, инструкции, промахи кеша, ошибки предсказания
+const int PROFILE_COUNTERS = 4;
+
+struct ProfileCounterValues {
+    uint64_t value[PROFILE_COUNTERS] = {};
+};
+
+// Накопленные данные фазы; обновляются атомарно из любых потоков
+struct ProfilePhase {
+    string name;
+    atomic<uint64_t> calls{0};
+    atomic<uint64_t> ticks{0};
+    atomic<uint64_t> counters[PROFILE_COUNTERS] = {};
+
+    explicit ProfilePhase(const string& name) : name(name) {}
+};
+
+// Группа счетчиков perf_event_open одного потока (счетчики считают только
+// поток, который их открыл)
+class ProfileCounterGroup {
+public:
+    ProfileCounterGroup() {
+#ifdef PROFILER_PERF
+        static const uint64_t configs[PROFILE_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < PROFILE_COUNTERS; i++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            int fd = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+            if (fd < 0) {
+                close();
+                return;
+            }
+            fds[i] = fd;
+        }
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        ok = true;
+#endif
+    }
+
+    ~ProfileCounterGroup() { close(); }
+
+    bool active() const { return ok; }
+
+    void read(ProfileCounterValues& out) const {
+#ifdef PROFILER_PERF
+        // PERF_FORMAT_GROUP: число счетчиков, затем значения
+        uint64_t buffer[1 + PROFILE_COUNTERS];
+        if (ok && ::read(fds[0], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer))) {
+            for (int i = 0; i < PROFILE_COUNTERS; i++) out.value[i] = buffer[1 + i];
+        }
+#else
+        (void)out;
+#endif
+    }
+
+private:
+    int fds[PROFILE_COUNTERS] = {-1, -1, -1, -1};
+    bool ok = false;
+
+    void close() {
+#ifdef PROFILER_PERF
+        for (int& fd : fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+#endif
+        ok = false;
+    }
+};
+
+// Событие трассы: один вызов фазы
+struct ProfileEvent {
+    const ProfilePhase* phase;
+    uint64_t start;
+    uint64_t end;
+};
+
+// Трасса одного потока; забирается в отчет и после завершения потока
+struct ProfileThreadTrace {
+    int tid = 0;
+    mutex lock;
+    vector<ProfileEvent> events;
+};
+
+class Profiler {
+public:
+    Profiler() {
+        startTicks = profileTicks();
+        startTime = chrono::steady_clock::now();
+        const char* out = getenv("LABA6_PROFILE_OUT");
+        summaryPath = out && *out ? out : "laba6_profile.json";
+        const char* trace = getenv("LABA6_PROFILE_TRACE");
+        if (trace && *trace) tracePath = trace;
+        const char* counters = getenv("LABA6_PROFILE_COUNTERS");
+        useCounters = counters && strcmp(counters, "0") != 0;
+    }
+
+    // Отчет пишется при завершении программы
+    ~Profiler() { writeReports(); }
+
+    // Фаза по имени (одна на имя, адрес не меняется)
+    ProfilePhase& phase(const char* name) {
+        lock_guard<mutex> guard(lock);
+        for (ProfilePhase& p : phases)
+            if (p.name == name) return p;
+        phases.emplace_back(name);
+        return phases.back();
+    }
+
+    bool tracing() const { return !tracePath.empty(); }
+    bool countersRequested() const { return useCounters; }
+
+    shared_ptr<ProfileThreadTrace> registerThread() {
+        auto trace = make_shared<ProfileThreadTrace>();
+        lock_guard<mutex> guard(lock);
+        trace->tid = static_cast<int>(traces.size()) + 1;
+        traces.push_back(trace);
+        return trace;
+    }
+
+    void countersUnavailable() { countersFailed = true; }
+
+    void writeReports() {
+        if (written.exchange(true)) return;
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        uint64_t ticks = profileTicks() - startTicks;
+        // Частота тактов по всему времени работы программы
+        double ticksPerSecond = seconds > 0 ? ticks / seconds : 1e9;
+
+        writeSummary(ticksPerSecond);
+        if (tracing()) writeTrace(ticksPerSecond);
+    }
+
+private:
+    mutex lock;
+    deque<ProfilePhase> phases;
+    vector<shared_ptr<ProfileThreadTrace>> traces;
+    uint64_t startTicks;
+    chrono::steady_clock::time_point startTime;
+    string summaryPath, tracePath;
+    bool useCounters = false;
+    atomic<bool> countersFailed{false};
+    atomic<bool> written{false};
+
+    static void writeName(ostream& out, const string& name) {
+        out << '"';
+        for (char c : name) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+
+    void writeSummary(double ticksPerSecond) {
+        ofstream out(summaryPath);
+        if (!out) {
+            cerr << "Профиль: не удалось записать " << summaryPath << "\n";
+            return;
+        }
+        bool counters = useCounters && !countersFailed;
+        out << "{\n  \"ticks_per_second\": " << static_cast<uint64_t>(ticksPerSecond)
+            << ",\n  \"counters\": " << (counters ? "true" : "false") << ",\n  \"phases\": [";
+        lock_guard<mutex> guard(lock);
+        bool first = true;
+        for (const ProfilePhase& p : phases) {
+            uint64_t calls = p.calls.load();
+            if (calls == 0) continue;
+            uint64_t ticks = p.ticks.load();
+            out << (first ? "\n" : ",\n") << "    {\"name\": ";
+            writeName(out, p.name);
+            out << ", \"calls\": " << calls << ", \"ticks\": " << ticks
+                << ", \"seconds\": " << ticks / ticksPerSecond
+                << ", \"ticks_per_call\": " << ticks / calls;
+            if (counters) {
+                uint64_t cycles = p.counters[0].load(), instructions = p.counters[1].load();
+                out << ", \"cycles\": " << cycles << ", \"instructions\": " << instructions
+                    << ", \"ipc\": " << (cycles ? static_cast<double>(instructions) / cycles : 0.0)
+                    << ", \"cache_misses\": " << p.counters[2].load()
+                    << ", \"branch_misses\": " << p.counters[3].load();
+            }
+            out << "}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+        cerr << "Профиль записан в " << summaryPath << "\n";
+    }
+
+    void writeTrace(double ticksPerSecond) {
+        ofstream out(tracePath);
+        if (!out) {
+            cerr << "Профиль: не удалось записать " << tracePath << "\n";
+            return;
+        }
+        // Время событий - в микросекундах от запуска программы
+        double usPerTick = 1e6 / ticksPerSecond;
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        lock_guard<mutex> guard(lock);
+        bool first = true;
+        for (const auto& trace : traces) {
+            lock_guard<mutex> traceGuard(trace->lock);
+            for (const ProfileEvent& e : trace->events) {
+                out << (first ? "\n" : ",\n") << "{\"name\": ";
+                writeName(out, e.phase->name);
+                out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << trace->tid
+                    << ", \"ts\": " << (e.start - startTicks) * usPerTick
+                    << ", \"dur\": " << (e.end - e.start) * usPerTick << "}";
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+        cerr << "Трасса записана в " << tracePath << "\n";
+    }
+};
+
+inline Profiler& profiler() {
+    static Profiler instance;
+    return instance;
+}
+
+// Состояние профилировщика в потоке: счетчики и трасса открываются при
+// первом замере в потоке
+struct ProfileThreadState {
+    unique_ptr<ProfileCounterGroup> counters;
+    shared_ptr<ProfileThreadTrace> trace;
+
+    ProfileThreadState() {
+        Profiler& p = profiler();
+        if (p.countersRequested()) {
+            counters = make_unique<ProfileCounterGroup>();
+            if (!counters->active()) {
+                p.countersUnavailable();
+                counters.reset();
+            }
+        }
+        if (p.tracing()) trace = p.registerThread();
+    }
+};
+
+inline ProfileThreadState& profileThread() {
+    static thread_local ProfileThreadState state;
+    return state;
+}
+
+// Замер от конструктора до деструктора
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase& phase) : phase(phase), thread(profileThread()) {
+        if (thread.counters) thread.counters->read(startCounters);
+        start = profileTicks();
+    }
+
+    ~ProfileScope() {
+        uint64_t end = profileTicks();
+        phase.calls.fetch_add(1, memory_order_relaxed);
+        phase.ticks.fetch_add(end - start, memory_order_relaxed);
+        if (thread.counters) {
+            ProfileCounterValues now;
+            thread.counters->read(now);
+            for (int i = 0; i < PROFILE_COUNTERS; i++)
+                phase.counters[i].fetch_add(now.value[i] - startCounters.value[i], memory_order_relaxed);
+        }
+        if (thread.trace) {
+            lock_guard<mutex> guard(thread.trace->lock);
+            thread.trace->events.push_back({&phase, start, end});
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfilePhase& phase;
+    ProfileThreadState& thread;
+    ProfileCounterValues startCounters;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// Фаза ищется по имени один раз на место вызова
+#define PROFILE_SCOPE(name)                                                            \
+    static ProfilePhase& PROFILE_CONCAT(profilePhase_, __LINE__) = profiler().phase(name); \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profilePhase_, __LINE__))
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+#endif // LABA6_PROFILE
+
+#endif // PROFILER_H
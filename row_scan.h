@@ -0,0 +1,178 @@
+#ifndef ROW_SCAN_H
+#define ROW_SCAN_H
+
+// Поиск строки с наибольшим количеством положительных чисел (laba6_11.cpp):
+// непрерывная матрица, векторный подсчет (AVX2 / AVX-512 с выбором во время
+// выполнения) и параллельный обход строк.
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+#include "profiler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ROW_SCAN_X86 1
+#endif
+
+using namespace std;
+
+// Матрица целых чисел в одном непрерывном блоке памяти (по строкам)
+struct IntMatrix {
+    int rows = 0;
+    int cols = 0;
+    vector<int> data;
+
+    IntMatrix() = default;
+    IntMatrix(int rows, int cols)
+        : rows(rows), cols(cols), data(static_cast<size_t>(rows) * cols) {}
+
+    int* operator[](int i) { return data.data() + static_cast<size_t>(i) * cols; }
+    const int* operator[](int i) const { return data.data() + static_cast<size_t>(i) * cols; }
+};
+
+// Строка матрицы без копирования данных
+struct RowView {
+    const int* data = nullptr;
+    int size = 0;
+
+    const int* begin() const { return data; }
+    const int* end() const { return data + size; }
+};
+
+// Количество положительных чисел в строке - без ветвлений
+inline int countPositiveScalar(const int* row, int n) {
+    int count = 0;
+    for (int j = 0; j < n; ++j) {
+        count += row[j] > 0;
+    }
+    return count;
+}
+
+#ifdef ROW_SCAN_X86
+// AVX2: сравнение 8 чисел с нулем за инструкцию; маска сравнения (-1 или 0)
+// вычитается из счетчиков дорожек
+__attribute__((target("avx2")))
+inline int countPositiveAVX2(const int* row, int n) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero, acc1 = zero;
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j + 8));
+        acc0 = _mm256_sub_epi32(acc0, _mm256_cmpgt_epi32(v0, zero));
+        acc1 = _mm256_sub_epi32(acc1, _mm256_cmpgt_epi32(v1, zero));
+    }
+    for (; j + 8 <= n; j += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+        acc0 = _mm256_sub_epi32(acc0, _mm256_cmpgt_epi32(v, zero));
+    }
+
+    // Горизонтальная сумма счетчиков дорожек
+    __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    int count = _mm_cvtsi128_si32(sum);
+
+    return count + countPositiveScalar(row + j, n - j);
+}
+
+// AVX-512: сравнение сразу дает 16-битную маску, которая считается popcount;
+// хвост строки обрабатывается загрузкой по маске
+__attribute__((target("avx512f,popcnt")))
+inline int countPositiveAVX512(const int* row, int n) {
+    const __m512i zero = _mm512_setzero_si512();
+    int count = 0;
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512i v = _mm512_loadu_si512(row + j);
+        count += _mm_popcnt_u32(_mm512_cmpgt_epi32_mask(v, zero));
+    }
+    if (j < n) {
+        __mmask16 tail = static_cast<__mmask16>((1u << (n - j)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(tail, row + j);
+        count += _mm_popcnt_u32(_mm512_mask_cmpgt_epi32_mask(tail, v, zero));
+    }
+    return count;
+}
+#endif
+
+using CountPositiveFn = int (*)(const int*, int);
+
+// Выбор самой быстрой реализации, поддерживаемой процессором
+inline CountPositiveFn selectCountPositive() {
+#ifdef ROW_SCAN_X86
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("popcnt")) return countPositiveAVX512;
+    if (__builtin_cpu_supports("avx2")) return countPositiveAVX2;
+#endif
+    return countPositiveScalar;
+}
+
+// Результат поиска: индекс строки и количество положительных в ней
+// (-1, -1 для матрицы без строк)
+struct RowScanResult {
+    int index = -1;
+    int count = -1;
+};
+
+// Лучший из двух результатов: больше положительных, при равенстве - меньший индекс
+inline RowScanResult betterRow(const RowScanResult& a, const RowScanResult& b) {
+    if (a.count != b.count) return a.count > b.count ? a : b;
+    if (a.index < 0) return b;
+    if (b.index < 0) return a;
+    return a.index < b.index ? a : b;
+}
+
+// Поиск строки с наибольшим количеством положительных чисел.
+// Строки делятся на непрерывные куски по потокам (threads = 0 - по числу ядер),
+// каждый поток находит свой максимум, затем максимумы сливаются с тем же
+// правилом, что и в последовательном обходе: при равенстве побеждает строка
+// с меньшим индексом.
+inline RowScanResult findRowWithMostPositives(const IntMatrix& matrix, int threads = 0) {
+    PROFILE_SCOPE("findRowWithMostPositives");
+    CountPositiveFn countPositive = selectCountPositive();
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, matrix.rows));
+
+    auto scanRange = [&](int from, int to) {
+        RowScanResult best;
+        for (int i = from; i < to; ++i) {
+            int countPos = countPositive(matrix[i], matrix.cols);
+            if (countPos > best.count) {
+                best.count = countPos;
+                best.index = i;
+            }
+        }
+        return best;
+    };
+
+    if (threads == 1) {
+        return scanRange(0, matrix.rows);
+    }
+
+    vector<RowScanResult> partial(threads);
+    vector<thread> pool;
+    int chunk = (matrix.rows + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        int from = t * chunk;
+        int to = min(matrix.rows, from + chunk);
+        pool.emplace_back([&, t, from, to]() { partial[t] = scanRange(from, to); });
+    }
+    for (thread& th : pool) th.join();
+
+    RowScanResult best;
+    for (const RowScanResult& r : partial) {
+        best = betterRow(best, r);
+    }
+    return best;
+}
+
+// Строка матрицы как представление (без копирования)
+inline RowView rowView(const IntMatrix& matrix, int index) {
+    return RowView{matrix[index], matrix.cols};
+}
+
+#endif // ROW_SCAN_H